@@ -1,10 +1,13 @@
 #include NAVBOT_PCH_FILE
+#include <chrono>
 #include <extension.h>
 #include <manager.h>
 #include <extplayer.h>
 #include <util/helpers.h>
 #include <util/entprops.h>
 #include <util/sdkcalls.h>
+#include <util/memory_tracker.h>
+#include <util/hotpath_profiler.h>
 #include <mods/basemod.h>
 #include <tier1/convar.h>
 #include <sdkports/sdk_takedamageinfo.h>
@@ -108,11 +111,16 @@ void CBaseBot::PlayerThink()
 	VPROF_BUDGET("CBaseBot::PlayerThink", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	// memory allocated and time spent while thinking is accounted to this bot
+	memtracker::OwnerScope memscope(GetIndex());
+	hotprof::BotScope profscope(GetIndex());
+	NAVBOT_PROFILE_SCOPE("CBaseBot::PlayerThink");
+
 	CBaseExtPlayer::PlayerThink(); // Call base class function first
 
 	m_debugtextoffset = 0;
 
-	if (IsDebugging(BOTDEBUG_TASKS))
+	if (IsDebugging(BOTDEBUG_TASKS) || IsDebugging(BOTDEBUG_MISC))
 	{
 		DebugFrame();
 	}
@@ -149,12 +157,17 @@ void CBaseBot::PlayerThink()
 	int buttons = 0;
 	auto control = GetControlInterface();
 
-	if (m_nextupdatetime.IsElapsed())
+	CBotUpdateScheduler& scheduler = extmanager->GetBotUpdateScheduler();
+
+	if (scheduler.ShouldUpdate(this, m_nextupdatetime))
 	{
-		m_nextupdatetime.Start(extmanager->GetMod()->GetModSettings()->GetUpdateRate());
+		const auto start = std::chrono::steady_clock::now();
 
 		Update(); // Run period update
 
+		const auto end = std::chrono::steady_clock::now();
+		scheduler.OnUpdateFinished(this, m_nextupdatetime, std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+
 		// Process all buttons during updates
 		control->ProcessButtons(buttons);
 	}
@@ -196,6 +209,7 @@ void CBaseBot::Reset()
 	m_nextupdatetime.Invalidate();
 	m_lastPrerequisite = nullptr;
 	m_clearLastPrerequisiteTimer.Invalidate();
+	m_lod.Reset();
 	m_weaponselect = 0;
 	m_weaponsubtype = 0;
 
@@ -211,6 +225,8 @@ void CBaseBot::Update()
 	VPROF_BUDGET("CBaseBot::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CBaseBot::Update");
+
 	const float curtime = gpGlobals->curtime;
 
 	m_lastUpdateDelta = curtime - m_lastUpdateTime;
@@ -225,6 +241,8 @@ void CBaseBot::Update()
 		m_lastPrerequisite = nullptr;
 	}
 
+	m_lod.Update(this);
+
 	for (auto iface : m_interfaces)
 	{
 		iface->Update();
@@ -24,6 +24,7 @@
 #include "interfaces/sharedmemory.h"
 #include "interfaces/combat.h"
 #include "interfaces/pathprocessor.h"
+#include "bot_lod.h"
 
 // Interval between calls to Update()
 constexpr auto BOT_UPDATE_INTERVAL = 0.07f;
@@ -306,6 +307,8 @@ public:
 	 * @return Nearest entity between the two.
 	 */
 	CBaseEntity* SelectNearestEntity(CBaseEntity* first, CBaseEntity* second) const;
+	// Returns the bot AI level of detail
+	const CBotLOD& GetLOD() const { return m_lod; }
 protected:
 	bool m_isfirstspawn;
 
@@ -348,6 +351,7 @@ private:
 	CMeshNavigator* m_activeNavigator;
 	const CNavPrerequisite* m_lastPrerequisite; // Last prerequisite this bot used
 	CountdownTimer m_clearLastPrerequisiteTimer;
+	CBotLOD m_lod; // AI level of detail
 
 	void ExecuteQueuedCommands();
 };
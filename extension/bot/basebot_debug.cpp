@@ -112,7 +112,9 @@ void CBaseBot::DebugDisplayText(const char* text)
 
 void CBaseBot::DebugFrame()
 {
-	char text[8];
+	char text[64];
 	ke::SafeSprintf(text, sizeof(text), "#%i", GetIndex());
 	DebugDisplayText(text);
+	ke::SafeSprintf(text, sizeof(text), "AI LOD: %s", CBotLOD::GetLevelName(m_lod.GetLevel()));
+	DebugDisplayText(text);
 }
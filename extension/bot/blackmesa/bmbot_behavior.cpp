@@ -1,5 +1,6 @@
 #include NAVBOT_PCH_FILE
 #include <extension.h>
+#include <util/hotpath_profiler.h>
 #include "bmbot.h"
 #include "bmbot_behavior.h"
 #include <bot/blackmesa/tasks/bmbot_main_task.h>
@@ -23,6 +24,7 @@ void CBlackMesaBotBehavior::Reset()
 
 void CBlackMesaBotBehavior::Update()
 {
+	NAVBOT_PROFILE_SCOPE("IBehavior::Update");
 	m_manager->Update(GetBot<CBlackMesaBot>());
 }
 
@@ -21,6 +21,7 @@ public:
 	const CKnownEntity* SelectTargetThreat(CBaseBot* me, const CKnownEntity* threat1, const CKnownEntity* threat2) override;
 	QueryAnswerType ShouldPickup(CBaseBot* me, CBaseEntity* item) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_DEBUG_MOVE_TO_COMMAND) | EventBit(EVENT_KILLED); }
 	const char* GetName() const override { return "MainTask"; }
 private:
 	IBotAimHelper<CBlackMesaBot> m_aimhelper;
@@ -19,6 +19,7 @@ public:
 	TaskEventResponseResult<CBlackMesaBot> OnNavAreaChanged(CBlackMesaBot* bot, CNavArea* oldArea, CNavArea* newArea) override;
 	TaskEventResponseResult<CBlackMesaBot> OnPluginCommand(CBlackMesaBot* bot, IEventListener::PluginCommandTypes type, const IEventListener::PluginCommandData& data) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "TacticalMonitor"; }
 private:
 	CountdownTimer m_healthScanTimer;
@@ -0,0 +1,184 @@
+#include NAVBOT_PCH_FILE
+#include <array>
+#include <algorithm>
+#include <cmath>
+
+#include <extension.h>
+#include <manager.h>
+#include <extplayer.h>
+#include <bot/basebot.h>
+#include "bot_lod.h"
+
+#ifdef EXT_VPROF_ENABLED
+#include <tier0/vprof.h>
+#endif // EXT_VPROF_ENABLED
+
+static ConVar cvar_lod_enabled("sm_navbot_lod_enabled", "1", FCVAR_GAMEDLL, "Enables the AI level of detail system. Bots far away from human players use cheaper AI.");
+static ConVar cvar_lod_reduced_range("sm_navbot_lod_reduced_range", "2000", FCVAR_GAMEDLL, "Bots farther than this from any human player use the reduced AI level of detail.", true, 0.0f, false, 0.0f);
+static ConVar cvar_lod_minimal_range("sm_navbot_lod_minimal_range", "4000", FCVAR_GAMEDLL, "Bots farther than this from any human player and outside their PVS use the minimal AI level of detail.", true, 0.0f, false, 0.0f);
+static ConVar cvar_lod_hysteresis("sm_navbot_lod_hysteresis", "250", FCVAR_GAMEDLL, "Distance margin around the LOD ranges to prevent bots from switching levels too often.", true, 0.0f, false, 0.0f);
+static ConVar cvar_lod_min_time("sm_navbot_lod_min_time", "2.0", FCVAR_GAMEDLL, "Minimum time in seconds a bot stays in a LOD level before switching to a lower detail level.", true, 0.0f, true, 30.0f);
+
+namespace botlod
+{
+	// PVS buffer for the LOD checks, separated from the sensor PVS since this is evaluated in the middle of the bot update
+	static std::array<byte, MAX_MAP_CLUSTERS / 8> s_pvs{};
+}
+
+CBotLOD::CBotLOD()
+{
+	Reset();
+}
+
+const char* CBotLOD::GetLevelName(Level level)
+{
+	switch (level)
+	{
+	case Level::LOD_FULL:
+		return "FULL";
+	case Level::LOD_REDUCED:
+		return "REDUCED";
+	case Level::LOD_MINIMAL:
+		return "MINIMAL";
+	default:
+		return "ERROR";
+	}
+}
+
+void CBotLOD::Reset()
+{
+	m_level = Level::LOD_FULL;
+	m_nearestHumanDistance = -1.0f;
+	m_inHumanPVS = false;
+	m_evaluateTimer.Invalidate();
+	m_levelTimer.Start();
+}
+
+void CBotLOD::Update(CBaseBot* bot)
+{
+	if (!cvar_lod_enabled.GetBool())
+	{
+		m_level = Level::LOD_FULL;
+		return;
+	}
+
+	if (m_evaluateTimer.HasStarted() && !m_evaluateTimer.IsElapsed())
+	{
+		return;
+	}
+
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CBotLOD::Update", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	m_evaluateTimer.Start(EVALUATE_INTERVAL);
+
+	const Level target = ComputeTargetLevel(bot);
+
+	if (target == m_level)
+	{
+		return;
+	}
+
+	// switching to a higher detail level is instant, lower detail levels must wait
+	if (target > m_level && m_levelTimer.IsLessThen(cvar_lod_min_time.GetFloat()))
+	{
+		return;
+	}
+
+	if (bot->IsDebugging(BOTDEBUG_MISC))
+	{
+		bot->DebugPrintToConsole(0, 180, 255, "%s: AI LOD changed from %s to %s. Nearest human: %3.2f In PVS: %s \n", bot->GetDebugIdentifier(),
+			GetLevelName(m_level), GetLevelName(target), m_nearestHumanDistance, m_inHumanPVS ? "YES" : "NO");
+	}
+
+	m_level = target;
+	m_levelTimer.Start();
+}
+
+int CBotLOD::GetSensorUpdateSkips() const
+{
+	switch (m_level)
+	{
+	case Level::LOD_REDUCED:
+		return 1;
+	case Level::LOD_MINIMAL:
+		return 3;
+	default:
+		return 0;
+	}
+}
+
+float CBotLOD::GetScanIntervalScale() const
+{
+	switch (m_level)
+	{
+	case Level::LOD_REDUCED:
+		return 2.0f;
+	case Level::LOD_MINIMAL:
+		return 4.0f;
+	default:
+		return 1.0f;
+	}
+}
+
+CBotLOD::Level CBotLOD::ComputeTargetLevel(CBaseBot* bot)
+{
+	const Vector eyePos = bot->GetEyeOrigin();
+	float nearestSqr = -1.0f;
+	bool inPVS = false;
+
+	engine->ResetPVS(botlod::s_pvs.data(), static_cast<int>(botlod::s_pvs.size()));
+	engine->AddOriginToPVS(eyePos);
+
+	auto func = [&eyePos, &nearestSqr, &inPVS](CBaseExtPlayer* player) {
+		if (player->IsFakeClient() || !player->IsAlive())
+		{
+			return;
+		}
+
+		const Vector humanEyes = player->GetEyeOrigin();
+		const float distSqr = (humanEyes - eyePos).LengthSqr();
+
+		if (nearestSqr < 0.0f || distSqr < nearestSqr)
+		{
+			nearestSqr = distSqr;
+		}
+
+		if (!inPVS && engine->CheckOriginInPVS(humanEyes, botlod::s_pvs.data(), static_cast<int>(botlod::s_pvs.size())))
+		{
+			inPVS = true;
+		}
+	};
+
+	extmanager->ForEachPlayer(func);
+
+	m_nearestHumanDistance = nearestSqr >= 0.0f ? std::sqrt(nearestSqr) : -1.0f;
+	m_inHumanPVS = inPVS;
+
+	// Move the boundaries towards the current level so bots near a boundary don't keep switching levels
+	const float hysteresis = cvar_lod_hysteresis.GetFloat();
+	float reducedRange = cvar_lod_reduced_range.GetFloat();
+	float minimalRange = std::max(cvar_lod_minimal_range.GetFloat(), reducedRange);
+	reducedRange += IsAtLeast(Level::LOD_REDUCED) ? -hysteresis : hysteresis;
+	minimalRange += IsAtLeast(Level::LOD_MINIMAL) ? -hysteresis : hysteresis;
+
+	Level target = Level::LOD_FULL;
+
+	if (m_nearestHumanDistance < 0.0f || m_nearestHumanDistance > minimalRange)
+	{
+		target = Level::LOD_MINIMAL;
+	}
+	else if (m_nearestHumanDistance > reducedRange)
+	{
+		target = Level::LOD_REDUCED;
+	}
+
+	// humans may be able to see the bot or the bot is fighting, keep aim and path following at full fidelity
+	if (target == Level::LOD_MINIMAL && (inPVS || bot->GetCombatInterface()->IsInCombat()))
+	{
+		target = Level::LOD_REDUCED;
+	}
+
+	return target;
+}
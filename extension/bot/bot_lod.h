@@ -0,0 +1,59 @@
+#ifndef __NAVBOT_BOT_LOD_H_
+#define __NAVBOT_BOT_LOD_H_
+#pragma once
+
+#include <cstdint>
+#include <sdkports/sdk_timers.h>
+
+class CBaseBot;
+
+/**
+ * @brief AI level of detail of a bot.
+ *
+ * Bots far away from human players and out of their PVS switch to cheaper AI modes.
+ */
+class CBotLOD
+{
+public:
+	enum class Level : std::uint8_t
+	{
+		LOD_FULL = 0U, // Full fidelity AI
+		LOD_REDUCED, // Slower sensor and danger scan updates, no small obstacle avoidance traces
+		LOD_MINIMAL, // Slowest sensor updates, no danger scans, no aim smoothing and straight path following along segment goals
+
+		MAX_LOD_LEVELS
+	};
+
+	static constexpr float EVALUATE_INTERVAL = 0.5f; // interval between LOD evaluations
+
+	CBotLOD();
+
+	static const char* GetLevelName(Level level);
+
+	void Reset();
+	// Re-evaluates the LOD level, called by the bot on updates
+	void Update(CBaseBot* bot);
+
+	Level GetLevel() const { return m_level; }
+	// True if the bot current LOD level is the given level or lower detail
+	bool IsAtLeast(Level level) const { return static_cast<std::uint8_t>(m_level) >= static_cast<std::uint8_t>(level); }
+	// Distance to the nearest alive human player on the last evaluation, negative if there were none
+	float GetNearestHumanDistance() const { return m_nearestHumanDistance; }
+	// True if the bot was inside the PVS of a human player on the last evaluation
+	bool IsInHumanPVS() const { return m_inHumanPVS; }
+	// Number of updates the sensor should skip between vision updates
+	int GetSensorUpdateSkips() const;
+	// Multiplier for the danger scan and obstacle scan intervals
+	float GetScanIntervalScale() const;
+
+private:
+	Level m_level;
+	float m_nearestHumanDistance;
+	bool m_inHumanPVS;
+	CountdownTimer m_evaluateTimer;
+	IntervalTimer m_levelTimer; // time since the last level change
+
+	Level ComputeTargetLevel(CBaseBot* bot);
+};
+
+#endif // !__NAVBOT_BOT_LOD_H_
@@ -16,6 +16,42 @@ void HumanMovementCaps_t::Init(IMovement* movement)
 	m_candoublejump = movement->IsAbleToDoubleJump();
 }
 
+bool IGroundPathCost::GetCacheKey(std::uint64_t& key) const
+{
+	if (m_moveiface == nullptr || m_moveiface->HasCostModAreas())
+	{
+		return false;
+	}
+
+	std::uint64_t hash = CNavPathCache::HASH_SEED;
+	hash = CNavPathCache::HashCombine(hash, m_movecaps.m_stepheight);
+	hash = CNavPathCache::HashCombine(hash, m_movecaps.m_maxjumpheight);
+	hash = CNavPathCache::HashCombine(hash, m_movecaps.m_maxdropheight);
+	hash = CNavPathCache::HashCombine(hash, m_movecaps.m_maxgapjumpdistance);
+	hash = CNavPathCache::HashCombine(hash, m_movecaps.m_maxdjheight);
+
+	std::uint32_t flags = 0U;
+	flags |= m_movecaps.m_candoublejump ? 1U : 0U;
+	flags |= m_moveiface->IsAbleToBlastJump() ? 2U : 0U;
+	flags |= m_ignoreDanger ? 4U : 0U;
+	// off-mesh connection abilities, grappling hooks depend on the bot inventory
+	flags |= m_moveiface->IsAbleToUseGrapplingHook() ? 8U : 0U;
+	flags |= m_moveiface->IsAbleToStrafeJump() ? 16U : 0U;
+	hash = CNavPathCache::HashCombine(hash, flags);
+	hash = CNavPathCache::HashCombine(hash, static_cast<std::uint32_t>(GetRouteType()));
+	hash = CNavPathCache::HashCombine(hash, static_cast<std::uint32_t>(m_teamindex));
+	key = hash;
+	return true;
+}
+
+bool IGroundPathCost::IsDangerSensitive(int& teamID) const
+{
+	teamID = m_teamindex;
+
+	// Fastest routes always ignores danger
+	return !m_ignoreDanger && GetRouteType() != FASTEST_ROUTE;
+}
+
 float IGroundPathCost::GetGroundMovementCost(CNavArea* toArea, CNavArea* fromArea, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator, float length) const
 {
 #ifdef EXT_VPROF_ENABLED
@@ -5,6 +5,7 @@
 */
 
 #include <array>
+#include <cstdint>
 #include "interfaces/path/basepath.h"
 #include <navmesh/nav_consts.h>
 
@@ -70,6 +71,9 @@ public:
 	bool IsIngoringDanger() const { return m_ignoreDanger; }
 	void SetTeamIndex(int index) { m_teamindex = index; }
 	int GetTeamIndex() const { return m_teamindex; }
+	// Hashes the movement capabilities, team, route type and danger setting. Not cacheable if the bot has per area cost multipliers.
+	bool GetCacheKey(std::uint64_t& key) const override;
+	bool IsDangerSensitive(int& teamID) const override;
 
 protected:
 	HumanMovementCaps_t m_movecaps;
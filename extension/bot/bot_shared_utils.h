@@ -183,6 +183,8 @@ namespace botsharedutils
 
 	/**
 	 * @brief Utility class for spreading danger around nearby areas.
+	 *
+	 * Runs a search immediately, game events should use CNavDangerMap::QueueSpread so spreads are batched.
 	 */
 	class SpreadDangerToNearbyAreas : public INavAreaCollector<CNavArea>
 	{
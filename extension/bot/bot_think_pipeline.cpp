@@ -0,0 +1,161 @@
+#include NAVBOT_PCH_FILE
+#include <algorithm>
+
+#include <extension.h>
+#include <manager.h>
+#include <mods/modhelpers.h>
+#include <util/helpers.h>
+#include <bot/basebot.h>
+#include <util/hotpath_profiler.h>
+#include "bot_think_pipeline.h"
+
+#ifdef EXT_VPROF_ENABLED
+#include <tier0/vprof.h>
+#endif // EXT_VPROF_ENABLED
+
+static ConVar cvar_vision_prefilter("sm_navbot_vision_prefilter", "1", FCVAR_GAMEDLL, "If enabled, the players in vision range of each bot are collected once per frame for all bots.");
+
+CBotThinkPipeline::CBotThinkPipeline()
+{
+	m_players.reserve(MAX_CLIENTS);
+	m_bots.reserve(64);
+	Reset();
+}
+
+void CBotThinkPipeline::Reset()
+{
+	m_players.clear();
+	m_bots.clear();
+	m_botSlots.fill(-1);
+	m_tick = -1;
+}
+
+void CBotThinkPipeline::Run()
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CBotThinkPipeline::Run", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	if (!cvar_vision_prefilter.GetBool())
+	{
+		// bots test every client during their own think
+		m_tick = -1;
+		return;
+	}
+
+	NAVBOT_PROFILE_SCOPE("CBotThinkPipeline::Run");
+
+	Gather();
+	Decide();
+	Apply();
+}
+
+const std::vector<int>* CBotThinkPipeline::GetVisionCandidates(int client) const
+{
+	if (m_tick < 0 || client < 0 || client >= MAX_CLIENTS)
+	{
+		return nullptr;
+	}
+
+	// results are from the end of the last tick
+	if (gpGlobals->tickcount - m_tick > 1)
+	{
+		return nullptr;
+	}
+
+	const int slot = m_botSlots[client];
+
+	if (slot < 0)
+	{
+		return nullptr;
+	}
+
+	return &m_bots[slot].visionCandidates;
+}
+
+void CBotThinkPipeline::Gather()
+{
+	NAVBOT_PROFILE_SCOPE("CBotThinkPipeline::Gather");
+
+	m_tick = -1;
+	m_players.clear();
+	m_botSlots.fill(-1);
+
+	for (int i = 1; i <= gpGlobals->maxClients && i < MAX_CLIENTS; i++)
+	{
+		CBaseEntity* entity = gamehelpers->ReferenceToEntity(i);
+
+		if (!entity) { continue; }
+
+		if (!modhelpers->IsPlayableTeam(modhelpers->GetEntityTeamNumber(entity))) { continue; }
+
+		m_players.push_back({ i, UtilHelpers::getWorldSpaceCenter(entity) });
+	}
+
+	std::size_t count = 0U;
+
+	auto func = [this, &count](CBaseBot* bot) {
+		if (!bot->IsAlive() || bot->GetIndex() >= MAX_CLIENTS)
+		{
+			return;
+		}
+
+		// reuse the slots to keep the vector capacities
+		if (count == m_bots.size())
+		{
+			m_bots.emplace_back();
+			m_bots.back().visionCandidates.reserve(MAX_CLIENTS);
+			m_bots.back().sortBuffer.reserve(MAX_CLIENTS);
+		}
+
+		BotThinkData& data = m_bots[count];
+		const float range = bot->GetSensorInterface()->GetMaxVisionRange() + VISION_RANGE_PADDING;
+		data.index = bot->GetIndex();
+		data.eyePos = bot->GetEyeOrigin();
+		data.visionRangeSqr = range * range;
+		data.visionCandidates.clear();
+		m_botSlots[data.index] = static_cast<int>(count);
+		count++;
+	};
+
+	extmanager->ForEachBot(func);
+
+	m_bots.resize(count);
+}
+
+void CBotThinkPipeline::Decide()
+{
+	NAVBOT_PROFILE_SCOPE("CBotThinkPipeline::Decide");
+
+	for (BotThinkData& data : m_bots)
+	{
+		data.sortBuffer.clear();
+
+		for (const PlayerSnapshot& player : m_players)
+		{
+			if (player.index == data.index)
+			{
+				continue;
+			}
+
+			const float distSqr = (player.center - data.eyePos).LengthSqr();
+
+			if (distSqr <= data.visionRangeSqr)
+			{
+				data.sortBuffer.emplace_back(distSqr, player.index);
+			}
+		}
+
+		std::sort(data.sortBuffer.begin(), data.sortBuffer.end());
+
+		for (auto& pair : data.sortBuffer)
+		{
+			data.visionCandidates.push_back(pair.second);
+		}
+	}
+}
+
+void CBotThinkPipeline::Apply()
+{
+	m_tick = gpGlobals->tickcount;
+}
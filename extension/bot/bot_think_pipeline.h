@@ -0,0 +1,62 @@
+#ifndef __NAVBOT_BOT_THINK_PIPELINE_H_
+#define __NAVBOT_BOT_THINK_PIPELINE_H_
+#pragma once
+
+#include <array>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Prepares per bot data shared by the bot thinks of the next tick.
+ *
+ * Runs once per server frame after all bots have thought in three phases:
+ * Gather: engine state is copied.
+ * Decide: each bot data is computed from the gathered state.
+ * Apply: results are published and consumed by the bots on their next think.
+ */
+class CBotThinkPipeline
+{
+public:
+	static constexpr int MAX_CLIENTS = 256;
+	// extra range added to the vision range since the data is one tick old when used
+	static constexpr float VISION_RANGE_PADDING = 128.0f;
+
+	CBotThinkPipeline();
+
+	void Reset();
+	// Runs the pipeline for all bots.
+	void Run();
+	/**
+	 * @brief Gets the players the bot may be able to see, sorted by distance.
+	 * @param client Bot client index.
+	 * @return Vector of client indexes or NULL if the pipeline doesn't have up to date data for this bot.
+	 */
+	const std::vector<int>* GetVisionCandidates(int client) const;
+
+private:
+	struct PlayerSnapshot
+	{
+		int index;
+		Vector center;
+	};
+
+	struct BotThinkData
+	{
+		int index;
+		Vector eyePos;
+		float visionRangeSqr;
+		std::vector<int> visionCandidates;
+		std::vector<std::pair<float, int>> sortBuffer;
+	};
+
+	std::vector<PlayerSnapshot> m_players;
+	std::vector<BotThinkData> m_bots;
+	std::array<int, MAX_CLIENTS> m_botSlots; // client index to m_bots index, -1 if none
+	int m_tick; // tick the results were applied, -1 if there are no results
+
+	void Gather();
+	void Decide();
+	void Apply();
+};
+
+#endif // !__NAVBOT_BOT_THINK_PIPELINE_H_
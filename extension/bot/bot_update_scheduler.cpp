@@ -0,0 +1,279 @@
+#include NAVBOT_PCH_FILE
+#include <algorithm>
+#include <cmath>
+
+#include <extension.h>
+#include <manager.h>
+#include <extplayer.h>
+#include <mods/basemod.h>
+#include <bot/basebot.h>
+#include <bot/interfaces/combat.h>
+#include <bot/interfaces/sensor.h>
+#include "bot_update_scheduler.h"
+
+static ConVar cvar_update_budget("sm_navbot_update_budget_us", "0", FCVAR_GAMEDLL, "Time budget in microseconds for bot AI updates per server tick. 0 for no limit.", true, 0.0f, false, 0.0f);
+static ConVar cvar_update_priority_range("sm_navbot_update_priority_range", "1500", FCVAR_GAMEDLL, "Bots within this distance of a human player are high priority for AI updates. 0 to disable.", true, 0.0f, false, 0.0f);
+static ConVar cvar_update_max_stretch("sm_navbot_update_max_stretch", "4", FCVAR_GAMEDLL, "Maximum update interval multiplier for low priority bots when the update budget is overloaded.", true, 1.0f, true, 16.0f);
+static ConVar cvar_update_max_defer("sm_navbot_update_max_defer", "0.5", FCVAR_GAMEDLL, "Maximum time in seconds a low priority bot update can be deferred by the update budget.", true, 0.0f, true, 5.0f);
+
+namespace botscheduler
+{
+	// weight of the last tick on the average tick cost
+	static constexpr double AVERAGE_COST_WEIGHT = 0.1;
+	// stretch factor change per tick
+	static constexpr float STRETCH_STEP = 0.05f;
+	// the stretch factor starts recovering when the average cost goes below this fraction of the budget
+	static constexpr double RECOVER_THRESHOLD = 0.75;
+	static constexpr double GOLDEN_RATIO_CONJUGATE = 0.6180339887498949;
+}
+
+CBotUpdateScheduler::CBotUpdateScheduler()
+{
+	m_humanPositions.reserve(32);
+	Reset();
+}
+
+void CBotUpdateScheduler::Reset()
+{
+	for (auto& state : m_bots)
+	{
+		state.dueSince = -1.0f;
+		state.highPriority = false;
+	}
+
+	m_humanPositions.clear();
+	m_tick = -1;
+	m_tickCost = 0;
+	m_lastTickCost = 0;
+	m_averageCost = 0.0;
+	m_stretch = 1.0f;
+	m_tickDeferred = 0;
+	m_lastTickDeferred = 0;
+	ResetStats();
+}
+
+void CBotUpdateScheduler::OnBotRemoved(int client)
+{
+	if (client < 0 || client >= MAX_TRACKED_BOTS)
+	{
+		return;
+	}
+
+	m_bots[client].dueSince = -1.0f;
+	m_bots[client].highPriority = false;
+}
+
+bool CBotUpdateScheduler::ShouldUpdate(CBaseBot* bot, CountdownTimer& nextUpdateTimer)
+{
+	const int tick = gpGlobals->tickcount;
+
+	if (tick != m_tick)
+	{
+		BeginTick(tick);
+	}
+
+	const int index = bot->GetIndex();
+
+	if (!nextUpdateTimer.HasStarted())
+	{
+		// New bot or the bot was reset, spread the first update over one interval so bots added at the same time don't update on the same tick
+		const double phase = std::fmod(static_cast<double>(index) * botscheduler::GOLDEN_RATIO_CONJUGATE, 1.0);
+		nextUpdateTimer.Start(GetBaseInterval() * static_cast<float>(phase));
+		return false;
+	}
+
+	if (!nextUpdateTimer.IsElapsed())
+	{
+		return false;
+	}
+
+	if (index < 0 || index >= MAX_TRACKED_BOTS)
+	{
+		return true;
+	}
+
+	BotState& state = m_bots[index];
+	const float now = gpGlobals->curtime;
+
+	if (state.dueSince < 0.0f)
+	{
+		state.dueSince = now;
+	}
+
+	state.highPriority = IsHighPriority(bot);
+
+	const std::int64_t budget = static_cast<std::int64_t>(cvar_update_budget.GetInt());
+
+	if (budget > 0 && !state.highPriority && m_tickCost >= budget)
+	{
+		if ((now - state.dueSince) < cvar_update_max_defer.GetFloat())
+		{
+			m_tickDeferred++;
+			m_stats.deferred++;
+			return false;
+		}
+
+		m_stats.forced++;
+	}
+
+	return true;
+}
+
+void CBotUpdateScheduler::OnUpdateFinished(CBaseBot* bot, CountdownTimer& nextUpdateTimer, std::int64_t elapsedMicroseconds)
+{
+	m_tickCost += std::max<std::int64_t>(elapsedMicroseconds, 0);
+	m_stats.updates++;
+
+	float interval = GetBaseInterval();
+	const int index = bot->GetIndex();
+
+	if (index >= 0 && index < MAX_TRACKED_BOTS)
+	{
+		BotState& state = m_bots[index];
+		state.dueSince = -1.0f;
+
+		if (state.highPriority)
+		{
+			m_stats.highPriorityUpdates++;
+		}
+		else
+		{
+			interval *= m_stretch;
+		}
+	}
+
+	nextUpdateTimer.Start(interval);
+}
+
+void CBotUpdateScheduler::ResetStats()
+{
+	m_stats.updates = 0U;
+	m_stats.deferred = 0U;
+	m_stats.forced = 0U;
+	m_stats.highPriorityUpdates = 0U;
+}
+
+int CBotUpdateScheduler::GetHighPriorityCount() const
+{
+	int count = 0;
+
+	for (auto& state : m_bots)
+	{
+		if (state.highPriority)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+int CBotUpdateScheduler::GetPendingCount() const
+{
+	int count = 0;
+
+	for (auto& state : m_bots)
+	{
+		if (state.dueSince >= 0.0f)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void CBotUpdateScheduler::BeginTick(int tick)
+{
+	m_tick = tick;
+	m_lastTickCost = m_tickCost;
+	m_lastTickDeferred = m_tickDeferred;
+	m_averageCost += (static_cast<double>(m_tickCost) - m_averageCost) * botscheduler::AVERAGE_COST_WEIGHT;
+	m_tickCost = 0;
+	m_tickDeferred = 0;
+
+	const double budget = static_cast<double>(cvar_update_budget.GetInt());
+
+	if (budget <= 0.0)
+	{
+		m_stretch = 1.0f;
+	}
+	else if (m_averageCost > budget)
+	{
+		m_stretch = std::min(m_stretch + botscheduler::STRETCH_STEP, cvar_update_max_stretch.GetFloat());
+	}
+	else if (m_averageCost < budget * botscheduler::RECOVER_THRESHOLD)
+	{
+		m_stretch = std::max(m_stretch - botscheduler::STRETCH_STEP, 1.0f);
+	}
+
+	m_humanPositions.clear();
+
+	if (cvar_update_priority_range.GetFloat() <= 0.0f)
+	{
+		return;
+	}
+
+	auto func = [this](CBaseExtPlayer* player) {
+		if (!player->IsFakeClient() && player->IsAlive())
+		{
+			m_humanPositions.push_back(player->GetAbsOrigin());
+		}
+	};
+
+	extmanager->ForEachPlayer(func);
+}
+
+bool CBotUpdateScheduler::IsHighPriority(CBaseBot* bot) const
+{
+	if (bot->GetCombatInterface()->IsInCombat() || bot->GetSensorInterface()->GetVisibleEnemiesCount() > 0)
+	{
+		return true;
+	}
+
+	const float range = cvar_update_priority_range.GetFloat();
+
+	if (range <= 0.0f || m_humanPositions.empty())
+	{
+		return false;
+	}
+
+	const float rangeSqr = range * range;
+	const Vector& origin = bot->GetAbsOrigin();
+
+	for (auto& pos : m_humanPositions)
+	{
+		if ((pos - origin).LengthSqr() <= rangeSqr)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+float CBotUpdateScheduler::GetBaseInterval() const
+{
+	return extmanager->GetMod()->GetModSettings()->GetUpdateRate();
+}
+
+CON_COMMAND_F(sm_navbot_update_scheduler_stats, "Prints the bot update scheduler statistics.", FCVAR_GAMEDLL)
+{
+	CBotUpdateScheduler& scheduler = extmanager->GetBotUpdateScheduler();
+	const CBotUpdateScheduler::Stats& stats = scheduler.GetStats();
+
+	META_CONPRINTF("Bot Update Scheduler: \n");
+	META_CONPRINTF("  Budget: %i us per tick (0 = unlimited) \n", cvar_update_budget.GetInt());
+	META_CONPRINTF("  Last tick cost: %lld us, average: %.1f us \n", static_cast<long long>(scheduler.GetLastTickCost()), scheduler.GetAverageTickCost());
+	META_CONPRINTF("  Low priority interval stretch: %.2fx \n", scheduler.GetStretchFactor());
+	META_CONPRINTF("  High priority bots: %i, pending updates: %i, deferred last tick: %i \n", scheduler.GetHighPriorityCount(), scheduler.GetPendingCount(), scheduler.GetLastTickDeferred());
+	META_CONPRINTF("  Updates: %llu (high priority: %llu), deferred: %llu, forced over budget: %llu \n",
+		static_cast<unsigned long long>(stats.updates), static_cast<unsigned long long>(stats.highPriorityUpdates),
+		static_cast<unsigned long long>(stats.deferred), static_cast<unsigned long long>(stats.forced));
+}
+
+CON_COMMAND_F(sm_navbot_update_scheduler_reset_stats, "Resets the bot update scheduler statistics.", FCVAR_GAMEDLL)
+{
+	extmanager->GetBotUpdateScheduler().ResetStats();
+	META_CONPRINTF("Bot update scheduler statistics cleared. \n");
+}
@@ -0,0 +1,92 @@
+#ifndef __NAVBOT_BOT_UPDATE_SCHEDULER_H_
+#define __NAVBOT_BOT_UPDATE_SCHEDULER_H_
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <sdkports/sdk_timers.h>
+
+class CBaseBot;
+
+/**
+ * @brief Decides which bots are allowed to run a full AI update on the current tick.
+ *
+ * Update phases are staggered so bots added at the same time don't update on the same tick.
+ * If a per tick budget is set (sm_navbot_update_budget_us), low priority bots are deferred once the budget is spent and
+ * their update interval is stretched while the average cost per tick is over budget.
+ * Bots in combat or near human players are high priority and are never deferred or stretched.
+ */
+class CBotUpdateScheduler
+{
+public:
+	static constexpr int MAX_TRACKED_BOTS = 256;
+
+	struct Stats
+	{
+		std::uint64_t updates; // full updates ran
+		std::uint64_t deferred; // updates deferred because the budget was spent
+		std::uint64_t forced; // low priority updates ran over budget because they were deferred for too long
+		std::uint64_t highPriorityUpdates; // full updates ran by high priority bots
+	};
+
+	CBotUpdateScheduler();
+
+	// Clears the scheduler state, called on map start
+	void Reset();
+	// Called when a bot leaves the game
+	void OnBotRemoved(int client);
+	/**
+	 * @brief Checks if the bot should run a full update on this tick.
+	 * @param bot Bot to check.
+	 * @param nextUpdateTimer The bot update timer. An invalidated timer is given a staggered start.
+	 * @return True if the bot should call Update.
+	 */
+	bool ShouldUpdate(CBaseBot* bot, CountdownTimer& nextUpdateTimer);
+	/**
+	 * @brief Called after the bot runs a full update. Schedules the next update.
+	 * @param bot Bot that updated.
+	 * @param nextUpdateTimer The bot update timer.
+	 * @param elapsedMicroseconds Time spent on the update.
+	 */
+	void OnUpdateFinished(CBaseBot* bot, CountdownTimer& nextUpdateTimer, std::int64_t elapsedMicroseconds);
+
+	const Stats& GetStats() const { return m_stats; }
+	void ResetStats();
+	// Current update interval multiplier for low priority bots
+	float GetStretchFactor() const { return m_stretch; }
+	// Moving average of the time spent updating bots per tick in microseconds
+	double GetAverageTickCost() const { return m_averageCost; }
+	// Time spent updating bots on the last completed tick in microseconds
+	std::int64_t GetLastTickCost() const { return m_lastTickCost; }
+	// Number of updates deferred on the last completed tick
+	int GetLastTickDeferred() const { return m_lastTickDeferred; }
+	// Number of bots that were high priority on their last update check
+	int GetHighPriorityCount() const;
+	// Number of bots currently waiting for a deferred update
+	int GetPendingCount() const;
+
+private:
+	struct BotState
+	{
+		float dueSince; // time the bot became due for an update, negative if not waiting
+		bool highPriority;
+	};
+
+	void BeginTick(int tick);
+	bool IsHighPriority(CBaseBot* bot) const;
+	float GetBaseInterval() const;
+
+	std::array<BotState, MAX_TRACKED_BOTS> m_bots;
+	std::vector<Vector> m_humanPositions; // positions of alive human players, refreshed every tick
+	Stats m_stats;
+	int m_tick;
+	std::int64_t m_tickCost; // microseconds spent on the current tick
+	std::int64_t m_lastTickCost;
+	double m_averageCost;
+	float m_stretch;
+	int m_tickDeferred;
+	int m_lastTickDeferred;
+};
+
+#endif // !__NAVBOT_BOT_UPDATE_SCHEDULER_H_
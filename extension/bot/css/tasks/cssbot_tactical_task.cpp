@@ -47,9 +47,7 @@ TaskResult<CCSSBot> CCSSBotTacticalTask::OnTaskUpdate(CCSSBot* bot)
 
 TaskEventResponseResult<CCSSBot> CCSSBotTacticalTask::OnKilled(CCSSBot* bot, const CTakeDamageInfo& info)
 {
-	botsharedutils::SpreadDangerToNearbyAreas func{ bot->GetLastKnownNavArea(), static_cast<int>(bot->GetMyCSSTeam()), 1024.0f, CNavArea::ADD_DANGER_KILLED, CNavArea::MAX_DANGER_ONKILLED };
-
-	func.Execute();
+	TheNavMesh->GetDangerMap().QueueSpread(bot->GetLastKnownNavArea(), static_cast<int>(bot->GetMyCSSTeam()), 1024.0f, CNavArea::ADD_DANGER_KILLED, CNavArea::MAX_DANGER_ONKILLED);
 
 	return TryContinue(PRIORITY_LOW);
 }
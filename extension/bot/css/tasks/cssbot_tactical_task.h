@@ -13,6 +13,7 @@ public:
 	TaskEventResponseResult<CCSSBot> OnPluginCommand(CCSSBot* bot, IEventListener::PluginCommandTypes type, const IEventListener::PluginCommandData& data) override;
 	QueryAnswerType ShouldHurry(CBaseBot* me) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_KILLED) | EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_DANGEROUS_ENTITY_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "Tactical"; }
 private:
 	CountdownTimer m_gunEquipTimer;
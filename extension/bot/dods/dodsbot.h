@@ -68,6 +68,8 @@ public:
 
 	void SetRouteType(RouteType type) override { m_routetype = type; }
 	RouteType GetRouteType() const override { return m_routetype; }
+	// The path processor is notified of bomb blocked areas during the search, a cached path would skip that.
+	bool GetCacheKey(std::uint64_t& key) const override { return false; }
 private:
 	CDoDSBot* m_me;
 	CDoDSBotPathProcessor* m_dodpathprocessor;
@@ -1,5 +1,6 @@
 #include NAVBOT_PCH_FILE
 #include <extension.h>
+#include <util/hotpath_profiler.h>
 #include "dodsbot.h"
 #include "dodsbot_behavior.h"
 #include "tasks/dodsbot_main_task.h"
@@ -27,6 +28,7 @@ void CDoDSBotBehavior::Reset()
 
 void CDoDSBotBehavior::Update()
 {
+	NAVBOT_PROFILE_SCOPE("IBehavior::Update");
 	m_manager->Update(GetBot<CDoDSBot>());
 }
 
@@ -37,8 +37,7 @@ TaskEventResponseResult<CDoDSBot> CDoDSBotMainTask::OnDebugMoveToCommand(CDoDSBo
 
 TaskEventResponseResult<CDoDSBot> CDoDSBotMainTask::OnKilled(CDoDSBot* bot, const CTakeDamageInfo& info)
 {
-	botsharedutils::SpreadDangerToNearbyAreas spread{ bot->GetLastKnownNavArea(), static_cast<int>(bot->GetMyDoDTeam()), 600.0f, CNavArea::ADD_DANGER_KILLED, CNavArea::MAX_DANGER_ONKILLED };
-	spread.Execute();
+	TheNavMesh->GetDangerMap().QueueSpread(bot->GetLastKnownNavArea(), static_cast<int>(bot->GetMyDoDTeam()), 600.0f, CNavArea::ADD_DANGER_KILLED, CNavArea::MAX_DANGER_ONKILLED);
 
 	return TrySwitchTo(new CBotSharedDeadTask<CDoDSBot, CDoDSBotMainTask>, PRIORITY_MANDATORY, "I am dead!");
 }
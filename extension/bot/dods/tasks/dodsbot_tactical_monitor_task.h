@@ -14,6 +14,7 @@ public:
 	TaskEventResponseResult<CDoDSBot> OnDangerousEntityChanged(CDoDSBot* bot, CBaseEntity* newent, CBaseEntity* oldent) override;
 	TaskEventResponseResult<CDoDSBot> OnPluginCommand(CDoDSBot* bot, IEventListener::PluginCommandTypes type, const IEventListener::PluginCommandData& data) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_INJURED) | EventBit(EVENT_DANGEROUS_ENTITY_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "TacticalMonitor"; }
 private:
 	
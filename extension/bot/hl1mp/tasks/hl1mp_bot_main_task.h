@@ -20,6 +20,7 @@ public:
 	Vector GetAimPosition(CBaseBot* me, const Vector& pos, botweapons::AttackType attacktype = botweapons::AttackType::MAX_ATTACK_TYPES) override;
 	const CKnownEntity* SelectTargetThreat(CBaseBot* me, const CKnownEntity* threat1, const CKnownEntity* threat2) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_DEBUG_MOVE_TO_COMMAND) | EventBit(EVENT_KILLED); }
 	const char* GetName() const override { return "MainTask"; }
 private:
 	IBotAimHelper<CHL1MPBot> m_aimhelper;
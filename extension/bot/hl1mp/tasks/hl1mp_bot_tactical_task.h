@@ -15,6 +15,7 @@ public:
 
 	QueryAnswerType ShouldRetreat(CBaseBot* me) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "Tactical"; }
 
 private:
@@ -20,6 +20,7 @@ public:
 	TaskEventResponseResult<CInsMICBot> OnDebugMoveToCommand(CInsMICBot* bot, const Vector& moveTo) override;
 	TaskEventResponseResult<CInsMICBot> OnKilled(CInsMICBot* bot, const CTakeDamageInfo& info) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_DEBUG_MOVE_TO_COMMAND) | EventBit(EVENT_KILLED); }
 	const char* GetName() const override { return "Main"; }
 
 private:
@@ -12,6 +12,7 @@ public:
 	TaskEventResponseResult<CInsMICBot> OnNavAreaChanged(CInsMICBot* bot, CNavArea* oldArea, CNavArea* newArea) override;
 	TaskEventResponseResult<CInsMICBot> OnPluginCommand(CInsMICBot* bot, IEventListener::PluginCommandTypes type, const IEventListener::PluginCommandData& data) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "Tactical"; }
 
 private:
@@ -51,7 +51,7 @@ public:
 			{
 				pred::ProjectileData_t data;
 				data.FillFromAttackInfo(&weapon->GetWeaponInfo()->GetAttackInfo(type));
-				Vector predicted = pred::IterativeBallisticLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), data, maxiterations);
+				Vector predicted = pred::BallisticLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), data, maxiterations);
 
 				if (!bot->IsLineOfFireClear(predicted))
 				{
@@ -72,7 +72,7 @@ public:
 				}
 				else
 				{
-					predicted = pred::IterativeProjectileLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), projSpeed, maxiterations);
+					predicted = pred::ProjectileLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), projSpeed, maxiterations);
 				}
 
 				if (!bot->IsLineOfFireClear(predicted))
@@ -126,7 +126,7 @@ public:
 			{
 				pred::ProjectileData_t data;
 				data.FillFromAttackInfo(&weapon->GetWeaponInfo()->GetAttackInfo(type));
-				Vector predicted = pred::IterativeBallisticLead(GetShooterPosition(), target, GetTargetVelocity(), data, maxiterations);
+				Vector predicted = pred::BallisticLead(GetShooterPosition(), target, GetTargetVelocity(), data, maxiterations);
 
 				if (!bot->IsLineOfFireClear(predicted))
 				{
@@ -139,7 +139,7 @@ public:
 			if (weapon->GetWeaponInfo()->GetAttackInfo(type).IsProjectile())
 			{
 				const float projSpeed = weapon->GetWeaponInfo()->GetAttackInfo(type).GetProjectileSpeed();
-				Vector predicted = pred::IterativeProjectileLead(GetShooterPosition(), target, GetTargetVelocity(), projSpeed, maxiterations);
+				Vector predicted = pred::ProjectileLead(GetShooterPosition(), target, GetTargetVelocity(), projSpeed, maxiterations);
 
 				if (!bot->IsLineOfFireClear(predicted))
 				{
@@ -27,6 +27,9 @@ public:
 	// Called every server frame
 	virtual void Frame() = 0;
 
+	// Interfaces don't receive events unless they ask for them. Interfaces that handles events must override this.
+	EventMask GetEventInterestMask() override { return EVENTMASK_NONE; }
+
 private:
 	CBaseBot* m_bot; // The bot that this interface belongs to
 };
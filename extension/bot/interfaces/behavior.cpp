@@ -22,6 +22,22 @@ void IBehavior::Frame()
 {
 }
 
+IEventListener::EventMask IBehavior::GetEventInterestMask()
+{
+	EventMask mask = EVENTMASK_NONE;
+	auto vec = GetListenerVector();
+
+	if (vec)
+	{
+		for (auto listener : *vec)
+		{
+			mask |= listener->GetEventInterestMask();
+		}
+	}
+
+	return mask;
+}
+
 QueryAnswerType IBehavior::ShouldAttack(CBaseBot* me, const CKnownEntity* them)
 {
 	return GetDecisionQueryResponder()->ShouldAttack(me, them);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <util/hotpath_profiler.h>
 #include "tasks.h"
 #include "base_interface.h"
 #include "decisionquery.h"
@@ -20,6 +21,8 @@ public:
 	void Update() override;
 	// Called every server frame
 	void Frame() override;
+	// Events the task managers are interested in
+	EventMask GetEventInterestMask() override;
 
 	// Returns who will answer to decision queries
 	virtual IDecisionQuery* GetDecisionQueryResponder() = 0;
@@ -65,6 +68,7 @@ public:
 
 	void Update() override
 	{
+		NAVBOT_PROFILE_SCOPE("IBehavior::Update");
 		m_manager->Update(GetBot<Bot>());
 	}
 
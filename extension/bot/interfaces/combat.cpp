@@ -3,6 +3,7 @@
 #include <navmesh/nav_mesh.h>
 #include <bot/basebot.h>
 #include <bot/bot_shared_utils.h>
+#include <util/hotpath_profiler.h>
 #include "combat.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -75,6 +76,8 @@ void ICombat::Update()
 	VPROF_BUDGET("ICombat::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ICombat::Update");
+
 	if (!m_disableCombatTimer.IsElapsed()) { return; }
 
 	const CBaseBot* bot = GetBot<const CBaseBot>();
@@ -935,6 +938,8 @@ bool ICombat::CanScanForDanger() const
 
 	if (!GetBot<CBaseBot>()->GetDifficultyProfile()->IsAllowedToScanForDanger()) { return false; }
 
+	if (GetBot<CBaseBot>()->GetLOD().IsAtLeast(CBotLOD::Level::LOD_MINIMAL)) { return false; }
+
 	if (!m_dangerScanTimer.IsElapsed()) { return false; }
 
 	return true;
@@ -1176,10 +1181,12 @@ void ICombat::DangerScanUpdate()
 	VPROF_BUDGET("ICombat::DangerScanUpdate", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ICombat::DangerScanUpdate");
+
 	if (!CanScanForDanger()) { return; }
 
 	CBaseBot* bot = GetBot<CBaseBot>();
-	GetDangerScanTimer().Start(bot->GetDifficultyProfile()->GetDangerScanFrequency());
+	GetDangerScanTimer().Start(bot->GetDifficultyProfile()->GetDangerScanFrequency() * bot->GetLOD().GetScanIntervalScale());
 	UtilHelpers::CEntityEnumerator collector;
 	const float size = bot->GetDifficultyProfile()->GetDangerScanSize();
 	Vector vSize{ size, size, bot->GetMovementInterface()->GetStandingHullHeight() * 3.0f };
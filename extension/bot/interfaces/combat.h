@@ -77,6 +77,7 @@ public:
 	};
 
 	void OnNavAreaChanged(CNavArea* oldArea, CNavArea* newArea) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_NAV_AREA_CHANGED); }
 	void Reset() override;
 	void Update() override;
 	void Frame() override;
@@ -2,6 +2,7 @@
 #define __NAVBOT_BOT_EVENT_LISTENER_INTERFACE_H_
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <sp_vm_api.h>
 
@@ -90,8 +91,65 @@ public:
 		SourcePawn::IPluginFunction* sb_update_callback; // update
 	};
 
+	// Event types, one for each event function. Used for building interest masks.
+	enum EventType : int
+	{
+		EVENT_DEBUG_MOVE_TO_COMMAND = 0, // OnDebugMoveToCommand
+		EVENT_NAV_AREA_CHANGED, // OnNavAreaChanged
+		EVENT_STUCK, // OnStuck
+		EVENT_UNSTUCK, // OnUnstuck
+		EVENT_MOVE_TO_FAILURE, // OnMoveToFailure
+		EVENT_MOVE_TO_SUCCESS, // OnMoveToSuccess
+		EVENT_CONTACT, // OnContact
+		EVENT_IGNITED, // OnIgnited
+		EVENT_INJURED, // OnInjured
+		EVENT_KILLED, // OnKilled
+		EVENT_OTHER_KILLED, // OnOtherKilled
+		EVENT_SIGHT, // OnSight
+		EVENT_LOST_SIGHT, // OnLostSight
+		EVENT_SOUND, // OnSound
+		EVENT_ROUND_STATE_CHANGED, // OnRoundStateChanged
+		EVENT_FLAG_TAKEN, // OnFlagTaken
+		EVENT_FLAG_DROPPED, // OnFlagDropped
+		EVENT_CONTROL_POINT_CAPTURED, // OnControlPointCaptured
+		EVENT_CONTROL_POINT_LOST, // OnControlPointLost
+		EVENT_CONTROL_POINT_CONTESTED, // OnControlPointContested
+		EVENT_WEAPON_EQUIP, // OnWeaponEquip
+		EVENT_VOICE_COMMAND, // OnVoiceCommand
+		EVENT_TRUCE_CHANGED, // OnTruceChanged
+		EVENT_SQUAD_EVENT, // OnSquadEvent
+		EVENT_OBJECT_SAPPED, // OnObjectSapped
+		EVENT_GAME_EVENT, // OnGameEvent
+		EVENT_PATH_STATUS_CHANGED, // OnPathStatusChanged
+		EVENT_BOMB_PLANTED, // OnBombPlanted
+		EVENT_BOMB_DEFUSED, // OnBombDefused
+		EVENT_DANGEROUS_ENTITY_CHANGED, // OnDangerousEntityChanged
+		EVENT_CUSTOM_MOD_EVENT, // OnCustomModEvent
+		EVENT_PLUGIN_COMMAND, // OnPluginCommand
+
+		MAX_EVENT_TYPES
+	};
+
+	using EventMask = std::uint64_t;
+
+	static_assert(MAX_EVENT_TYPES <= 64, "Event types doesn't fit in EventMask!");
+
+	static constexpr EventMask EVENTMASK_NONE = 0U;
+	static constexpr EventMask EVENTMASK_ALL = ~static_cast<EventMask>(0U);
+
+	static constexpr EventMask EventBit(EventType type) { return static_cast<EventMask>(1U) << static_cast<EventMask>(type); }
+
 	// Gets a vector containing all event listeners
 	virtual std::vector<IEventListener*>* GetListenerVector() { return nullptr; }
+	/**
+	 * @brief Gets the events this listener (and the listeners below it) wants to receive.
+	 * 
+	 * Events not in the mask are not forwarded to this listener. Listeners that override an event function must include it here.
+	 * @return Event mask. See EventBit.
+	 */
+	virtual EventMask GetEventInterestMask() { return EVENTMASK_ALL; }
+	// Returns true if this listener wants to receive the given event type
+	bool IsInterestedInEvent(EventType type) { return (GetEventInterestMask() & EventBit(type)) != EVENTMASK_NONE; }
 
 	virtual void OnDebugMoveToCommand(const Vector& moveTo);
 	virtual void OnNavAreaChanged(CNavArea* oldArea, CNavArea* newArea);
@@ -135,7 +193,10 @@ inline void IEventListener::OnDebugMoveToCommand(const Vector& moveTo)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnDebugMoveToCommand(moveTo);
+			if (listener->IsInterestedInEvent(EVENT_DEBUG_MOVE_TO_COMMAND))
+			{
+				listener->OnDebugMoveToCommand(moveTo);
+			}
 		}
 	}
 }
@@ -148,7 +209,10 @@ inline void IEventListener::OnNavAreaChanged(CNavArea* oldArea, CNavArea* newAre
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnNavAreaChanged(oldArea, newArea);
+			if (listener->IsInterestedInEvent(EVENT_NAV_AREA_CHANGED))
+			{
+				listener->OnNavAreaChanged(oldArea, newArea);
+			}
 		}
 	}
 }
@@ -161,7 +225,10 @@ inline void IEventListener::OnStuck()
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnStuck();
+			if (listener->IsInterestedInEvent(EVENT_STUCK))
+			{
+				listener->OnStuck();
+			}
 		}
 	}
 }
@@ -174,7 +241,10 @@ inline void IEventListener::OnUnstuck()
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnUnstuck();
+			if (listener->IsInterestedInEvent(EVENT_UNSTUCK))
+			{
+				listener->OnUnstuck();
+			}
 		}
 	}
 }
@@ -187,7 +257,10 @@ inline void IEventListener::OnMoveToFailure(CPath* path, MovementFailureType rea
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnMoveToFailure(path, reason);
+			if (listener->IsInterestedInEvent(EVENT_MOVE_TO_FAILURE))
+			{
+				listener->OnMoveToFailure(path, reason);
+			}
 		}
 	}
 }
@@ -200,7 +273,10 @@ inline void IEventListener::OnMoveToSuccess(CPath* path)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnMoveToSuccess(path);
+			if (listener->IsInterestedInEvent(EVENT_MOVE_TO_SUCCESS))
+			{
+				listener->OnMoveToSuccess(path);
+			}
 		}
 	}
 }
@@ -213,7 +289,10 @@ inline void IEventListener::OnContact(CBaseEntity* pOther)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnContact(pOther);
+			if (listener->IsInterestedInEvent(EVENT_CONTACT))
+			{
+				listener->OnContact(pOther);
+			}
 		}
 	}
 }
@@ -226,7 +305,10 @@ inline void IEventListener::OnIgnited(const CTakeDamageInfo& info)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnIgnited(info);
+			if (listener->IsInterestedInEvent(EVENT_IGNITED))
+			{
+				listener->OnIgnited(info);
+			}
 		}
 	}
 }
@@ -239,7 +321,10 @@ inline void IEventListener::OnInjured(const CTakeDamageInfo& info)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnInjured(info);
+			if (listener->IsInterestedInEvent(EVENT_INJURED))
+			{
+				listener->OnInjured(info);
+			}
 		}
 	}
 }
@@ -252,7 +337,10 @@ inline void IEventListener::OnKilled(const CTakeDamageInfo& info)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnKilled(info);
+			if (listener->IsInterestedInEvent(EVENT_KILLED))
+			{
+				listener->OnKilled(info);
+			}
 		}
 	}
 }
@@ -265,7 +353,10 @@ inline void IEventListener::OnOtherKilled(CBaseEntity* pVictim, const CTakeDamag
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnOtherKilled(pVictim, info);
+			if (listener->IsInterestedInEvent(EVENT_OTHER_KILLED))
+			{
+				listener->OnOtherKilled(pVictim, info);
+			}
 		}
 	}
 }
@@ -278,7 +369,10 @@ inline void IEventListener::OnSight(CBaseEntity* subject)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnSight(subject);
+			if (listener->IsInterestedInEvent(EVENT_SIGHT))
+			{
+				listener->OnSight(subject);
+			}
 		}
 	}
 }
@@ -291,7 +385,10 @@ inline void IEventListener::OnLostSight(CBaseEntity* subject)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnLostSight(subject);
+			if (listener->IsInterestedInEvent(EVENT_LOST_SIGHT))
+			{
+				listener->OnLostSight(subject);
+			}
 		}
 	}
 }
@@ -304,7 +401,10 @@ inline void IEventListener::OnSound(CBaseEntity* source, const Vector& position,
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnSound(source, position, type, maxRadius);
+			if (listener->IsInterestedInEvent(EVENT_SOUND))
+			{
+				listener->OnSound(source, position, type, maxRadius);
+			}
 		}
 	}
 }
@@ -317,7 +417,10 @@ inline void IEventListener::OnRoundStateChanged()
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnRoundStateChanged();
+			if (listener->IsInterestedInEvent(EVENT_ROUND_STATE_CHANGED))
+			{
+				listener->OnRoundStateChanged();
+			}
 		}
 	}
 }
@@ -330,7 +433,10 @@ inline void IEventListener::OnFlagTaken(CBaseEntity* player)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnFlagTaken(player);
+			if (listener->IsInterestedInEvent(EVENT_FLAG_TAKEN))
+			{
+				listener->OnFlagTaken(player);
+			}
 		}
 	}
 }
@@ -343,7 +449,10 @@ inline void IEventListener::OnFlagDropped(CBaseEntity* player)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnFlagDropped(player);
+			if (listener->IsInterestedInEvent(EVENT_FLAG_DROPPED))
+			{
+				listener->OnFlagDropped(player);
+			}
 		}
 	}
 }
@@ -356,7 +465,10 @@ inline void IEventListener::OnControlPointCaptured(CBaseEntity* point)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnControlPointCaptured(point);
+			if (listener->IsInterestedInEvent(EVENT_CONTROL_POINT_CAPTURED))
+			{
+				listener->OnControlPointCaptured(point);
+			}
 		}
 	}
 }
@@ -369,7 +481,10 @@ inline void IEventListener::OnControlPointLost(CBaseEntity* point)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnControlPointLost(point);
+			if (listener->IsInterestedInEvent(EVENT_CONTROL_POINT_LOST))
+			{
+				listener->OnControlPointLost(point);
+			}
 		}
 	}
 }
@@ -382,7 +497,10 @@ inline void IEventListener::OnControlPointContested(CBaseEntity* point)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnControlPointContested(point);
+			if (listener->IsInterestedInEvent(EVENT_CONTROL_POINT_CONTESTED))
+			{
+				listener->OnControlPointContested(point);
+			}
 		}
 	}
 }
@@ -395,7 +513,10 @@ inline void IEventListener::OnWeaponEquip(CBaseEntity* weapon)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnWeaponEquip(weapon);
+			if (listener->IsInterestedInEvent(EVENT_WEAPON_EQUIP))
+			{
+				listener->OnWeaponEquip(weapon);
+			}
 		}
 	}
 }
@@ -408,7 +529,10 @@ inline void IEventListener::OnVoiceCommand(CBaseEntity* subject, int command)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnVoiceCommand(subject, command);
+			if (listener->IsInterestedInEvent(EVENT_VOICE_COMMAND))
+			{
+				listener->OnVoiceCommand(subject, command);
+			}
 		}
 	}
 }
@@ -421,7 +545,10 @@ inline void IEventListener::OnTruceChanged(const bool enabled)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnTruceChanged(enabled);
+			if (listener->IsInterestedInEvent(EVENT_TRUCE_CHANGED))
+			{
+				listener->OnTruceChanged(enabled);
+			}
 		}
 	}
 }
@@ -434,7 +561,10 @@ inline void IEventListener::OnSquadEvent(SquadEventType evtype)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnSquadEvent(evtype);
+			if (listener->IsInterestedInEvent(EVENT_SQUAD_EVENT))
+			{
+				listener->OnSquadEvent(evtype);
+			}
 		}
 	}
 }
@@ -447,7 +577,10 @@ inline void IEventListener::OnObjectSapped(CBaseEntity* owner, CBaseEntity* sabo
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnObjectSapped(owner, saboteur);
+			if (listener->IsInterestedInEvent(EVENT_OBJECT_SAPPED))
+			{
+				listener->OnObjectSapped(owner, saboteur);
+			}
 		}
 	}
 }
@@ -460,7 +593,10 @@ inline void IEventListener::OnGameEvent(const IGameEvent* event, void* moddata)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnGameEvent(event, moddata);
+			if (listener->IsInterestedInEvent(EVENT_GAME_EVENT))
+			{
+				listener->OnGameEvent(event, moddata);
+			}
 		}
 	}
 }
@@ -473,7 +609,10 @@ inline void IEventListener::OnPathStatusChanged()
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnPathStatusChanged();
+			if (listener->IsInterestedInEvent(EVENT_PATH_STATUS_CHANGED))
+			{
+				listener->OnPathStatusChanged();
+			}
 		}
 	}
 }
@@ -486,7 +625,10 @@ inline void IEventListener::OnBombPlanted(const Vector& position, const int team
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnBombPlanted(position, teamIndex, player, ent);
+			if (listener->IsInterestedInEvent(EVENT_BOMB_PLANTED))
+			{
+				listener->OnBombPlanted(position, teamIndex, player, ent);
+			}
 		}
 	}
 }
@@ -499,7 +641,10 @@ inline void IEventListener::OnBombDefused(const Vector& position, const int team
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnBombDefused(position, teamIndex, player, ent);
+			if (listener->IsInterestedInEvent(EVENT_BOMB_DEFUSED))
+			{
+				listener->OnBombDefused(position, teamIndex, player, ent);
+			}
 		}
 	}
 }
@@ -512,7 +657,10 @@ inline void IEventListener::OnDangerousEntityChanged(CBaseEntity* newent, CBaseE
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnDangerousEntityChanged(newent, oldent);
+			if (listener->IsInterestedInEvent(EVENT_DANGEROUS_ENTITY_CHANGED))
+			{
+				listener->OnDangerousEntityChanged(newent, oldent);
+			}
 		}
 	}
 }
@@ -525,7 +673,10 @@ inline void IEventListener::OnCustomModEvent(const int id, const std::any& data)
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnCustomModEvent(id, data);
+			if (listener->IsInterestedInEvent(EVENT_CUSTOM_MOD_EVENT))
+			{
+				listener->OnCustomModEvent(id, data);
+			}
 		}
 	}
 }
@@ -538,7 +689,10 @@ inline void IEventListener::OnPluginCommand(PluginCommandTypes type, const Plugi
 	{
 		for (auto listener : *vec)
 		{
-			listener->OnPluginCommand(type, data);
+			if (listener->IsInterestedInEvent(EVENT_PLUGIN_COMMAND))
+			{
+				listener->OnPluginCommand(type, data);
+			}
 		}
 	}
 }
@@ -6,6 +6,7 @@
 #include <mods/basemod.h>
 #include <util/entprops.h>
 #include <bot/basebot.h>
+#include <util/hotpath_profiler.h>
 #include "behavior.h"
 #include "knownentity.h"
 #include "inventory.h"
@@ -51,6 +52,8 @@ void IInventory::Update()
 	VPROF_BUDGET("IInventory::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("IInventory::Update");
+
 	if (m_updateWeaponsTimer.IsElapsed())
 	{
 		m_updateWeaponsTimer.Start(extmanager->GetMod()->GetModSettings()->GetInventoryUpdateRate());
@@ -808,6 +811,8 @@ const CBotWeapon* IInventory::FindBestWeaponAgainstThreat(const CKnownEntity* th
 	VPROF_BUDGET("IInventory::FindBestWeaponAgainstThreat", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("IInventory::FindBestWeaponAgainstThreat");
+
 	CBaseBot* bot = GetBot();
 	WeaponSelectData_t data(bot, threat);
 	const CBotWeapon* best = nullptr;
@@ -384,6 +384,7 @@ public:
 	virtual bool IsAmmoLow(const bool heldOnly = true);
 
 	void OnWeaponEquip(CBaseEntity* weapon) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_WEAPON_EQUIP); }
 	
 	// Number of valid weapons this bot owns
 	int GetOwnedWeaponCount() const;
@@ -13,6 +13,7 @@
 #include <mods/basemod.h>
 #include <entities/baseentity.h>
 #include <bot/interfaces/path/meshnavigator.h>
+#include <util/hotpath_profiler.h>
 #include "movement.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -190,6 +191,8 @@ void IMovement::Update()
 	VPROF_BUDGET("IMovement::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("IMovement::Update");
+
 	CBaseBot* me = GetBot<CBaseBot>();
 	m_maxspeed = me->GetMaxSpeed();
 
@@ -217,9 +220,7 @@ void IMovement::Update()
 	}
 
 	{
-		const float curTime = gpGlobals->curtime;
-		UpdateDeadAreas(curTime);
-		UpdateCostModAreas(curTime);
+		m_areaOverlay.Expire(gpGlobals->curtime);
 	}
 
 	// do this after the speeds calculations
@@ -1914,30 +1915,26 @@ bool IMovement::RequestMovementTypeChange(MovementType type, MovementRequestPrio
 
 void IMovement::AddDeadArea(CNavArea* area, const float duration)
 {
-	unsigned int id = area->GetID();
-	m_deadAreas[id] = duration;
+	m_areaOverlay.AddDeadArea(area->GetID(), duration < 0.0f ? -1.0f : gpGlobals->curtime + duration);
 }
 
 void IMovement::AddCostModArea(CNavArea* area, const float costMult, const float duration)
 {
-	unsigned int id = area->GetID();
-	auto& it = m_costModAreas[id];
-	it.first = costMult;
-	it.second = duration;
+	m_areaOverlay.AddCostModArea(area->GetID(), costMult, duration < 0.0f ? -1.0f : gpGlobals->curtime + duration);
 }
 
 bool IMovement::IsDeadArea(const CNavArea* area) const
 {
-	return m_deadAreas.find(area->GetID()) != m_deadAreas.end();
+	return m_areaOverlay.IsDeadArea(area->GetID());
 }
 
 void IMovement::GetCostMod(const CNavArea* area, float& cost) const
 {
-	auto it = m_costModAreas.find(area->GetID());
+	const unsigned int id = area->GetID();
 
-	if (it != m_costModAreas.end())
+	if (m_areaOverlay.HasCostMod(id))
 	{
-		cost *= it->first;
+		cost *= m_areaOverlay.GetCostMultiplier(id);
 	}
 }
 
@@ -3464,8 +3461,7 @@ void IMovement::_Reset()
 	m_movementType = IMovement::MovementType::MOVE_RUNNING;
 	m_lastMTRequestPriority = IMovement::MovementRequestPriority::MOVEREQUEST_PRIO_LOW;
 	m_MTRequestTimer.Invalidate();
-	m_deadAreas.clear();
-	m_costModAreas.clear();
+	m_areaOverlay.Clear();
 	m_pushLadderData.Reset();
 	m_simpleObstacleScanCooldown.Invalidate();
 }
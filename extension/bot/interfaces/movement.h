@@ -7,6 +7,7 @@
 #include <sdkports/sdk_traces.h>
 #include <navmesh/nav_consts.h>
 #include <navmesh/nav_elevator.h>
+#include "movement_area_overlay.h"
 
 class CNavLadder;
 class CNavArea;
@@ -250,6 +251,7 @@ public:
 	// Reset movement when killed to stop any movement action
 	void OnKilled(const CTakeDamageInfo& info) override { this->Reset(); }
 	void OnNavAreaChanged(CNavArea* oldArea, CNavArea* newArea) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_KILLED) | EventBit(EVENT_NAV_AREA_CHANGED); }
 
 	// Reset the interface to it's initial state
 	void Reset() override;
@@ -561,6 +563,8 @@ public:
 	bool IsDeadArea(const CNavArea* area) const;
 	// Applies a cost multiplier to the given area.
 	void GetCostMod(const CNavArea* area, float& cost) const;
+	// Returns true if any area is marked with a modified path cost.
+	bool HasCostModAreas() const { return m_areaOverlay.GetCostModAreaCount() > 0U; }
 	/**
 	 * @brief Starts using a push ladder. (Ladder made using push entities, generally trigger_push, 
 	 * @param goingup 
@@ -739,8 +743,8 @@ protected:
 	 */
 	void DoJumpAssist();
 
-	void ClearDeadAreas() { m_deadAreas.clear(); }
-	void ClearCostModAreas() { m_costModAreas.clear(); }
+	void ClearDeadAreas() { m_areaOverlay.ClearDeadAreas(); }
+	void ClearCostModAreas() { m_areaOverlay.ClearCostModAreas(); }
 
 private:
 	float m_speed; // Bot current speed
@@ -759,8 +763,7 @@ private:
 	Vector m_sjMidPoint; // strafe jump mid point
 	Vector m_sjEndPoint; // strafe jump end point
 	bool m_sjIsToTheLeft;
-	std::unordered_map<unsigned int, float> m_deadAreas; // nav areas marked as Dead
-	std::unordered_map<unsigned int, std::pair<float, float>> m_costModAreas; // nav areas marked with modified travel costs, first is cost multiplier, second is max time
+	CMovementAreaOverlay m_areaOverlay; // nav areas marked as dead or with modified travel costs
 	CountdownTimer m_simpleObstacleScanCooldown; // cooldown to avoid spamming scans and causing other issues
 
 	inline static float s_standingJumpBoost{ 30.0f };
@@ -803,36 +806,6 @@ private:
 
 	void _Reset();
 
-	void UpdateDeadAreas(const float timestamp)
-	{
-		for (auto it = m_deadAreas.begin(); it != m_deadAreas.end();)
-		{
-			if (it->second <= timestamp)
-			{
-				it = m_deadAreas.erase(it);
-			}
-			else
-			{
-				it++;
-			}
-		}
-	}
-
-	void UpdateCostModAreas(const float timestamp)
-	{
-		for (auto it = m_costModAreas.begin(); it != m_costModAreas.end();)
-		{
-			if (it->second.second <= timestamp)
-			{
-				it = m_costModAreas.erase(it);
-			}
-			else
-			{
-				it++;
-			}
-		}
-	}
-
 	bool UpdateCatapultLogic();
 	bool UpdatePushLadderLogic();
 
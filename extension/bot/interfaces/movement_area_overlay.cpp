@@ -0,0 +1,198 @@
+#include NAVBOT_PCH_FILE
+#include <algorithm>
+#include "movement_area_overlay.h"
+
+CMovementAreaOverlay::CMovementAreaOverlay()
+{
+	m_wheelEntries = 0U;
+	m_wheelCursor = -1;
+}
+
+void CMovementAreaOverlay::Clear()
+{
+	ClearDeadAreas();
+	ClearCostModAreas();
+
+	for (auto& slot : m_wheel)
+	{
+		slot.clear();
+	}
+
+	m_wheelEntries = 0U;
+	m_wheelCursor = -1;
+}
+
+void CMovementAreaOverlay::ClearDeadAreas()
+{
+	for (auto& entry : m_deadAreas)
+	{
+		SetBit(m_deadBits, entry.id, false);
+	}
+
+	m_deadAreas.clear();
+
+	// stale wheel entries are ignored when they expire
+}
+
+void CMovementAreaOverlay::ClearCostModAreas()
+{
+	for (auto& entry : m_costModAreas)
+	{
+		SetBit(m_costModBits, entry.id, false);
+	}
+
+	m_costModAreas.clear();
+}
+
+void CMovementAreaOverlay::AddDeadArea(unsigned int id, float expireTime)
+{
+	auto it = std::lower_bound(m_deadAreas.begin(), m_deadAreas.end(), id, [](const DeadEntry& entry, unsigned int value) { return entry.id < value; });
+
+	if (it != m_deadAreas.end() && it->id == id)
+	{
+		it->expireTime = expireTime;
+	}
+	else
+	{
+		m_deadAreas.insert(it, { id, expireTime });
+		SetBit(m_deadBits, id, true);
+	}
+
+	AddToWheel(id, expireTime, true);
+}
+
+void CMovementAreaOverlay::AddCostModArea(unsigned int id, float costMult, float expireTime)
+{
+	auto it = std::lower_bound(m_costModAreas.begin(), m_costModAreas.end(), id, [](const CostModEntry& entry, unsigned int value) { return entry.id < value; });
+
+	if (it != m_costModAreas.end() && it->id == id)
+	{
+		it->costMult = costMult;
+		it->expireTime = expireTime;
+	}
+	else
+	{
+		m_costModAreas.insert(it, { id, costMult, expireTime });
+		SetBit(m_costModBits, id, true);
+	}
+
+	AddToWheel(id, expireTime, false);
+}
+
+float CMovementAreaOverlay::GetCostMultiplier(unsigned int id) const
+{
+	if (!HasCostMod(id))
+	{
+		return 1.0f;
+	}
+
+	auto it = std::lower_bound(m_costModAreas.begin(), m_costModAreas.end(), id, [](const CostModEntry& entry, unsigned int value) { return entry.id < value; });
+
+	if (it != m_costModAreas.end() && it->id == id)
+	{
+		return it->costMult;
+	}
+
+	return 1.0f;
+}
+
+void CMovementAreaOverlay::Expire(float timestamp)
+{
+	if (m_wheelCursor < 0)
+	{
+		return;
+	}
+
+	const std::int64_t now = GetWheelTick(timestamp);
+	// visit every slot once at most, the slot of the current tick is visited again on the next call since it may have entries expiring later in the tick
+	const std::int64_t last = std::min(now, m_wheelCursor + static_cast<std::int64_t>(WHEEL_SLOTS) - 1);
+
+	for (std::int64_t tick = m_wheelCursor; tick <= last; tick++)
+	{
+		std::vector<WheelEntry>& slot = m_wheel[static_cast<std::size_t>(tick) % WHEEL_SLOTS];
+
+		for (std::size_t i = 0; i < slot.size();)
+		{
+			if (slot[i].expireTime <= timestamp)
+			{
+				ExpireEntry(slot[i]);
+				slot[i] = slot.back();
+				slot.pop_back();
+				m_wheelEntries--;
+				continue;
+			}
+
+			i++;
+		}
+	}
+
+	m_wheelCursor = m_wheelEntries == 0U ? -1 : std::max(now, m_wheelCursor);
+}
+
+void CMovementAreaOverlay::SetBit(std::vector<std::uint64_t>& bits, unsigned int id, bool value)
+{
+	const std::size_t word = static_cast<std::size_t>(id) >> 6;
+
+	if (word >= bits.size())
+	{
+		if (!value)
+		{
+			return;
+		}
+
+		bits.resize(word + 1U, 0U);
+	}
+
+	const std::uint64_t mask = std::uint64_t(1) << (id & 63U);
+
+	if (value)
+	{
+		bits[word] |= mask;
+	}
+	else
+	{
+		bits[word] &= ~mask;
+	}
+}
+
+void CMovementAreaOverlay::AddToWheel(unsigned int id, float expireTime, bool isDead)
+{
+	if (expireTime < 0.0f)
+	{
+		return; // never expires
+	}
+
+	const std::int64_t tick = GetWheelTick(expireTime);
+	m_wheel[static_cast<std::size_t>(tick) % WHEEL_SLOTS].push_back({ id, expireTime, isDead });
+	m_wheelEntries++;
+
+	if (m_wheelCursor < 0 || tick < m_wheelCursor)
+	{
+		m_wheelCursor = tick;
+	}
+}
+
+void CMovementAreaOverlay::ExpireEntry(const WheelEntry& entry)
+{
+	// the area may have been cleared or marked again with a different expire time since this entry was added
+	if (entry.isDead)
+	{
+		auto it = std::lower_bound(m_deadAreas.begin(), m_deadAreas.end(), entry.id, [](const DeadEntry& e, unsigned int value) { return e.id < value; });
+
+		if (it != m_deadAreas.end() && it->id == entry.id && it->expireTime == entry.expireTime)
+		{
+			m_deadAreas.erase(it);
+			SetBit(m_deadBits, entry.id, false);
+		}
+	}
+	else
+	{
+		auto it = std::lower_bound(m_costModAreas.begin(), m_costModAreas.end(), entry.id, [](const CostModEntry& e, unsigned int value) { return e.id < value; });
+
+		if (it != m_costModAreas.end() && it->id == entry.id && it->expireTime == entry.expireTime)
+		{
+			m_costModAreas.erase(it);
+			SetBit(m_costModBits, entry.id, false);
+		}
+	}
+}
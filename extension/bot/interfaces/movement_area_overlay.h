@@ -0,0 +1,92 @@
+#ifndef __NAVBOT_MOVEMENT_AREA_OVERLAY_H_
+#define __NAVBOT_MOVEMENT_AREA_OVERLAY_H_
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Per bot nav area overlay storing dead areas and areas with modified travel costs.
+ *
+ * Lookups are a bit test on a bitset indexed by area ID, cost multipliers are stored in a small sorted array.
+ * Timed entries are expired with a timer wheel.
+ */
+class CMovementAreaOverlay
+{
+public:
+	static constexpr float WHEEL_SLOT_DURATION = 0.25f;
+	static constexpr std::size_t WHEEL_SLOTS = 64U;
+
+	CMovementAreaOverlay();
+
+	void ClearDeadAreas();
+	void ClearCostModAreas();
+	void Clear();
+
+	/**
+	 * @brief Marks an area as dead.
+	 * @param id Area ID.
+	 * @param expireTime Time stamp when the mark expires, negative for never.
+	 */
+	void AddDeadArea(unsigned int id, float expireTime);
+	/**
+	 * @brief Marks an area with a travel cost multiplier.
+	 * @param id Area ID.
+	 * @param costMult Cost multiplier.
+	 * @param expireTime Time stamp when the mark expires, negative for never.
+	 */
+	void AddCostModArea(unsigned int id, float costMult, float expireTime);
+
+	bool IsDeadArea(unsigned int id) const { return TestBit(m_deadBits, id); }
+	bool HasCostMod(unsigned int id) const { return TestBit(m_costModBits, id); }
+	// Returns the cost multiplier of the given area, 1 if the area doesn't have one.
+	float GetCostMultiplier(unsigned int id) const;
+	// Removes expired entries
+	void Expire(float timestamp);
+
+	std::size_t GetDeadAreaCount() const { return m_deadAreas.size(); }
+	std::size_t GetCostModAreaCount() const { return m_costModAreas.size(); }
+
+private:
+	struct DeadEntry
+	{
+		unsigned int id;
+		float expireTime;
+	};
+
+	struct CostModEntry
+	{
+		unsigned int id;
+		float costMult;
+		float expireTime;
+	};
+
+	struct WheelEntry
+	{
+		unsigned int id;
+		float expireTime;
+		bool isDead; // true for dead areas, false for cost mod areas
+	};
+
+	std::vector<std::uint64_t> m_deadBits;
+	std::vector<std::uint64_t> m_costModBits;
+	std::vector<DeadEntry> m_deadAreas; // sorted by ID
+	std::vector<CostModEntry> m_costModAreas; // sorted by ID
+	std::array<std::vector<WheelEntry>, WHEEL_SLOTS> m_wheel;
+	std::size_t m_wheelEntries; // number of entries in the wheel
+	std::int64_t m_wheelCursor; // wheel tick of the last expire call, -1 if the wheel is empty
+
+	static bool TestBit(const std::vector<std::uint64_t>& bits, unsigned int id)
+	{
+		const std::size_t word = static_cast<std::size_t>(id) >> 6;
+		return word < bits.size() && (bits[word] & (std::uint64_t(1) << (id & 63U))) != 0;
+	}
+
+	static void SetBit(std::vector<std::uint64_t>& bits, unsigned int id, bool value);
+	static std::int64_t GetWheelTick(float timestamp) { return static_cast<std::int64_t>(timestamp / WHEEL_SLOT_DURATION); }
+	void AddToWheel(unsigned int id, float expireTime, bool isDead);
+	void ExpireEntry(const WheelEntry& entry);
+};
+
+#endif // !__NAVBOT_MOVEMENT_AREA_OVERLAY_H_
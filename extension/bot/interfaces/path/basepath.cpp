@@ -9,6 +9,7 @@
 #include <mods/basemod.h>
 #include <sdkports/debugoverlay_shared.h>
 #include <navmesh/nav_elevator.h>
+#include <util/hotpath_profiler.h>
 
 #include "basepath.h"
 
@@ -21,10 +22,11 @@
 #undef clamp
 
 static ConVar sm_navbot_path_segment_draw_limit("sm_navbot_path_segment_draw_limit", "25", FCVAR_GAMEDLL | FCVAR_DONTRECORD, "Path segment draw limit.");
+static ConVar sm_navbot_path_string_pull("sm_navbot_path_string_pull", "1", FCVAR_GAMEDLL | FCVAR_DONTRECORD, "If enabled, ground area crossings are pulled into straight lines between path corners.");
 static ConVar sm_navbot_path_max_segments("sm_navbot_path_max_segments", "128", FCVAR_GAMEDLL | FCVAR_DONTRECORD, "Maximum number of path segments. Affects performance.");
 
 CPath::CPath() :
-	m_ageTimer(), m_destination(0.0f, 0.0f, 0.0f)
+	m_ageTimer(), m_destination(0.0f, 0.0f, 0.0f), m_pathEndPos(0.0f, 0.0f, 0.0f)
 {
 	m_segments.reserve(512);
 	m_cursorPos = 0.0f;
@@ -68,6 +70,105 @@ bool CPath::BuildTrivialPath(const Vector& start, const Vector& goal)
 	return true;
 }
 
+bool CPath::BuildPathFromAreas(CBaseBot* bot, std::vector<PathArea>& chain)
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CPath::BuildPathFromAreas", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	const Vector destination = m_destination;
+	const Vector endPos = m_pathEndPos;
+	Invalidate();
+	m_destination = destination;
+
+	if (chain.size() < 2U)
+	{
+		OnPathChanged(bot, AIPath::ResultType::NO_PATH);
+		return false;
+	}
+
+	for (PathArea& entry : chain)
+	{
+		BotPathSegment* segment = &m_segments.emplace_back();
+		segment->area = entry.area;
+		segment->how = entry.how;
+	}
+
+	BotPathSegment* segment = &m_segments.emplace_back();
+	segment->area = chain.back().area;
+	segment->goal = endPos;
+	segment->type = AIPath::SegmentType::SEGMENT_GROUND;
+
+	m_pathAreas = std::move(chain);
+	m_pathEndPos = endPos;
+
+	if (!ProcessCurrentPath(bot, bot->GetAbsOrigin()))
+	{
+		Invalidate();
+		OnPathChanged(bot, AIPath::ResultType::NO_PATH);
+		return false;
+	}
+
+	PostProcessPath(bot);
+	OnPathChanged(bot, AIPath::ResultType::COMPLETE_PATH);
+	return true;
+}
+
+bool CPath::GetCachedPath(CBaseBot* bot, CNavArea* startArea, CNavArea* goalArea, std::uint64_t costKey, unsigned int dangerEpoch, std::vector<PathArea>& chain)
+{
+	CNavPathCache& cache = TheNavMesh->GetPathCache();
+	const CNavPathCache::Entry* entry = cache.Find(startArea, goalArea, bot->GetCurrentTeamIndex(), costKey, TheNavMesh->GetConnectivityEpoch(), dangerEpoch);
+
+	if (entry == nullptr)
+	{
+		return false;
+	}
+
+	// per bot dead areas, off-mesh connection abilities and elevator positions don't change the connectivity epoch, repeat the cost functor checks
+	IMovement* mover = bot->GetMovementInterface();
+
+	for (std::size_t i = 0; i < entry->areas.size(); i++)
+	{
+		const PathArea& pathArea = entry->areas[i];
+		bool usable = mover->IsAreaTraversable(pathArea.area);
+
+		if (usable && i > 0)
+		{
+			const CNavArea* fromArea = entry->areas[i - 1].area;
+
+			switch (pathArea.how)
+			{
+			case GO_OFF_MESH_CONNECTION:
+			{
+				const NavOffMeshConnection* link = fromArea->GetOffMeshConnectionToArea(pathArea.area);
+				usable = link != nullptr && mover->IsAbleToUseOffMeshConnection(link->GetType(), link);
+				break;
+			}
+			case GO_ELEVATOR_UP:
+				[[fallthrough]];
+			case GO_ELEVATOR_DOWN:
+			{
+				const CNavElevator::ElevatorFloor* fromFloor = fromArea->GetMyElevatorFloor();
+				usable = fromFloor != nullptr && (fromFloor->HasCallButton() || fromFloor->is_here);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		if (!usable)
+		{
+			cache.OnRejectedHit();
+			return false;
+		}
+	}
+
+	chain.assign(entry->areas.begin(), entry->areas.end());
+	SetTravelDistance(entry->travelDistance);
+	return true;
+}
+
 void CPath::Draw(const BotPathSegment* start, const float duration)
 {
 	int i = 0;
@@ -1162,6 +1263,8 @@ void CPath::PostProcessPath(CBaseBot* bot)
 	VPROF_BUDGET("CPath::PostProcessPath", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CPath::PostProcessPath");
+
 	if (m_segments.size() == 0)
 		return;
 
@@ -1176,6 +1279,11 @@ void CPath::PostProcessPath(CBaseBot* bot)
 		return;
 	}
 
+	if (sm_navbot_path_string_pull.GetBool())
+	{
+		StringPullPath(bot);
+	}
+
 	float currentDistance = 0.0f;
 	for (size_t i = 0; i < m_segments.size() - 1; i++)
 	{
@@ -1230,6 +1338,255 @@ void CPath::PostProcessPath(CBaseBot* bot)
 	m_ageTimer.Start();
 }
 
+static inline float StringPullCross2D(const Vector2D& a, const Vector2D& b)
+{
+	return (a.x * b.y) - (a.y * b.x);
+}
+
+void CPath::StringPullPath(CBaseBot* bot)
+{
+	NAVBOT_PROFILE_SCOPE("CPath::StringPullPath");
+
+	// keep the bot hull away from the portal edges
+	const float shrink = bot->GetMovementInterface()->GetHullWidth() * 0.5f;
+	size_t i = 1;
+
+	// pull each run of ground area crossings, the segments around the run are fixed
+	while (i + 1 < m_segments.size())
+	{
+		if (!IsStringPullable(i))
+		{
+			i++;
+			continue;
+		}
+
+		size_t last = i;
+
+		while (last + 2 < m_segments.size() && IsStringPullable(last + 1))
+		{
+			last++;
+		}
+
+		StringPullSegments(i, last, shrink);
+		i = last + 1;
+	}
+}
+
+bool CPath::IsStringPullable(const size_t index) const
+{
+	if (index == 0 || index + 1 >= m_segments.size())
+	{
+		return false;
+	}
+
+	const BotPathSegment& seg = m_segments[index];
+	const BotPathSegment& prior = m_segments[index - 1];
+	const BotPathSegment& next = m_segments[index + 1];
+
+	// segments around special segments are used as the start and end positions of jumps, ladders, links, ...
+	if (seg.type != AIPath::SegmentType::SEGMENT_GROUND || prior.type != AIPath::SegmentType::SEGMENT_GROUND || next.type != AIPath::SegmentType::SEGMENT_GROUND)
+	{
+		return false;
+	}
+
+	switch (seg.how)
+	{
+	case GO_NORTH:
+		[[fallthrough]];
+	case GO_EAST:
+		[[fallthrough]];
+	case GO_SOUTH:
+		[[fallthrough]];
+	case GO_WEST:
+		break;
+	default:
+		return false;
+	}
+
+	// inserted segment, not an area crossing
+	if (seg.area == prior.area)
+	{
+		return false;
+	}
+
+	if (seg.area->IsUnderwater() || prior.area->IsUnderwater())
+	{
+		return false;
+	}
+
+	// trust the mesh on precise areas
+	if (seg.area->HasAttributes(NAV_MESH_PRECISE) || prior.area->HasAttributes(NAV_MESH_PRECISE))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void CPath::StringPullSegments(const size_t first, const size_t last, const float shrink)
+{
+	// Funnel algorithm over the portals of the run, the start and end are the goals of the segments around the run
+	const int count = static_cast<int>(last - first) + 1;
+	std::vector<Vector2D> lefts;
+	std::vector<Vector2D> rights;
+	lefts.reserve(static_cast<size_t>(count) + 1U);
+	rights.reserve(static_cast<size_t>(count) + 1U);
+
+	for (int k = 0; k < count; k++)
+	{
+		const BotPathSegment& seg = m_segments[first + static_cast<size_t>(k)];
+		Vector2D dir;
+		DirectionToVector2D(static_cast<NavDirType>(seg.how), &dir);
+		const Vector2D center = seg.portalcenter.AsVector2D();
+		const float half = std::max(seg.portalhalfwidth - shrink, 0.0f);
+		Vector2D a = center;
+		Vector2D b = center;
+
+		if (seg.how == GO_NORTH || seg.how == GO_SOUTH)
+		{
+			a.x -= half;
+			b.x += half;
+		}
+		else
+		{
+			a.y -= half;
+			b.y += half;
+		}
+
+		// left is the side with a positive cross product with the travel direction
+		if (StringPullCross2D(dir, a - center) > 0.0f)
+		{
+			lefts.push_back(a);
+			rights.push_back(b);
+		}
+		else
+		{
+			lefts.push_back(b);
+			rights.push_back(a);
+		}
+	}
+
+	const Vector2D start = m_segments[first - 1].goal.AsVector2D();
+	const Vector2D end = m_segments[last + 1].goal.AsVector2D();
+	lefts.push_back(end);
+	rights.push_back(end);
+
+	// string vertices as portal index and position, -1 is the start and count is the end
+	std::vector<std::pair<int, Vector2D>> vertices;
+	vertices.emplace_back(-1, start);
+
+	Vector2D apex = start;
+	Vector2D portalLeft = start;
+	Vector2D portalRight = start;
+	int apexIndex = -1;
+	int leftIndex = -1;
+	int rightIndex = -1;
+	int iterations = (count + 2) * (count + 2); // guard against bad floating point input
+
+	for (int k = 0; k <= count && --iterations > 0; k++)
+	{
+		const Vector2D& left = lefts[static_cast<size_t>(k)];
+		const Vector2D& right = rights[static_cast<size_t>(k)];
+
+		// tighten the right side
+		if (StringPullCross2D(portalRight - apex, right - apex) >= 0.0f)
+		{
+			if (apex == portalRight || StringPullCross2D(portalLeft - apex, right - apex) < 0.0f)
+			{
+				portalRight = right;
+				rightIndex = k;
+			}
+			else
+			{
+				// right crossed over left, the left point is a corner
+				vertices.emplace_back(leftIndex, portalLeft);
+				apex = portalLeft;
+				apexIndex = leftIndex;
+				portalRight = apex;
+				rightIndex = apexIndex;
+				k = apexIndex;
+				continue;
+			}
+		}
+
+		// tighten the left side
+		if (StringPullCross2D(portalLeft - apex, left - apex) <= 0.0f)
+		{
+			if (apex == portalLeft || StringPullCross2D(portalRight - apex, left - apex) > 0.0f)
+			{
+				portalLeft = left;
+				leftIndex = k;
+			}
+			else
+			{
+				// left crossed over right, the right point is a corner
+				vertices.emplace_back(rightIndex, portalRight);
+				apex = portalRight;
+				apexIndex = rightIndex;
+				portalLeft = apex;
+				leftIndex = apexIndex;
+				k = apexIndex;
+				continue;
+			}
+		}
+	}
+
+	if (iterations <= 0)
+	{
+		return; // leave the crossings computed by the path processing
+	}
+
+	vertices.emplace_back(count, end);
+
+	// place every crossing on the string
+	for (size_t v = 0; v + 1 < vertices.size(); v++)
+	{
+		const int fromIndex = vertices[v].first;
+		const int toIndex = vertices[v + 1].first;
+		const Vector2D& a = vertices[v].second;
+		const Vector2D& b = vertices[v + 1].second;
+
+		if (toIndex < count)
+		{
+			BotPathSegment& corner = m_segments[first + static_cast<size_t>(toIndex)];
+			corner.goal.x = b.x;
+			corner.goal.y = b.y;
+			corner.goal.z = m_segments[first + static_cast<size_t>(toIndex) - 1].area->GetZ(corner.goal);
+			corner.straight = false;
+		}
+
+		for (int k = fromIndex + 1; k < toIndex; k++)
+		{
+			BotPathSegment& seg = m_segments[first + static_cast<size_t>(k)];
+			const Vector2D& portal = seg.portalcenter.AsVector2D();
+			const float half = std::max(seg.portalhalfwidth - shrink, 0.0f);
+			Vector2D point = portal;
+
+			if (seg.how == GO_NORTH || seg.how == GO_SOUTH)
+			{
+				if (std::abs(b.y - a.y) > 0.01f)
+				{
+					const float t = (portal.y - a.y) / (b.y - a.y);
+					point.x = std::clamp(a.x + (b.x - a.x) * t, portal.x - half, portal.x + half);
+				}
+			}
+			else
+			{
+				if (std::abs(b.x - a.x) > 0.01f)
+				{
+					const float t = (portal.x - a.x) / (b.x - a.x);
+					point.y = std::clamp(a.y + (b.y - a.y) * t, portal.y - half, portal.y + half);
+				}
+			}
+
+			seg.goal.x = point.x;
+			seg.goal.y = point.y;
+			seg.goal.z = m_segments[first + static_cast<size_t>(k) - 1].area->GetZ(seg.goal);
+			seg.straight = true;
+		}
+	}
+}
+
 void CPath::CentralizeAreaCrossing(CBaseBot* bot, const Vector& frompos, CNavArea* to, Vector* crosspoint)
 {
 	const Vector& center = to->GetCenter();
@@ -2,6 +2,7 @@
 #define SMNAV_BOT_BASE_PATH_H_
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <stack>
 #include <iterator>
@@ -10,6 +11,7 @@
 
 #include "path_shareddefs.h"
 #include <sdkports/sdk_timers.h>
+#include <util/memory_tracker.h>
 #include <bot/basebot.h>
 #include <navmesh/nav.h>
 #include <navmesh/nav_mesh.h>
@@ -41,6 +43,18 @@ public:
 
 	virtual void SetRouteType(RouteType type) = 0;
 	virtual RouteType GetRouteType() const = 0;
+	/**
+	 * @brief Gets a hash of everything that affects the costs returned by this functor. Used as a key of the nav mesh path cache.
+	 * @param key Hash output.
+	 * @return True if paths computed with this functor can be reused by other functors with the same key. False to never cache them.
+	 */
+	virtual bool GetCacheKey(std::uint64_t& key) const { return false; }
+	/**
+	 * @brief Checks if the costs returned by this functor depend on area danger. Cached paths are not reused once the danger changes.
+	 * @param teamID Team whose danger is used by this functor.
+	 * @return True if danger affects the costs.
+	 */
+	virtual bool IsDangerSensitive(int& teamID) const { return false; }
 
 	static constexpr float SOFTBLOCK_COST = 1e16f; // return this to 'soft' block the area.
 	static constexpr float DEADEND_COST = -1.0f; // return this to mark the area as dead end. (hard block)
@@ -66,8 +80,17 @@ public:
 		distance = 0.0f;
 		curvature = 0.0f;
 		portalhalfwidth = 0.0f;
+		clearance = Clearance::UNKNOWN;
+		straight = false;
 	}
 
+	enum class Clearance
+	{
+		UNKNOWN = 0, // not computed yet
+		CLEAR, // the corridor around this segment is free of world geometry
+		BLOCKED // world geometry near the corridor or the segment is not a straight walkable corridor
+	};
+
 	CNavArea* area; // The area that is part of this segment
 	Vector goal; // Movement goal position for this segment
 	NavTraverseType how; // How to approach this segment
@@ -79,6 +102,8 @@ public:
 	float curvature; // How much this path segment 'curves' (ranges from 0 (0) to 1 (180)
 	Vector portalcenter; // Segment portal center position
 	float portalhalfwidth; // Portal's half width
+	mutable Clearance clearance; // Static clearance cache, computed by the navigator when the bot moves along this segment
+	bool straight; // The string pulling pass placed this segment on a straight line between two path corners
 
 	bool operator==(const BotPathSegment& rhs) const
 	{
@@ -102,6 +127,8 @@ public:
 		this->curvature = other->curvature;
 		this->portalcenter = other->portalcenter;
 		this->portalhalfwidth = other->portalhalfwidth;
+		this->clearance = Clearance::UNKNOWN;
+		this->straight = false;
 	}
 };
 
@@ -131,6 +158,8 @@ public:
 	CPath();
 	virtual ~CPath();
 
+	using SegmentVector = std::vector<BotPathSegment, memtracker::TrackedAllocator<BotPathSegment, memtracker::Category::PATH_SEGMENTS>>;
+
 	class PathCursor
 	{
 	public:
@@ -175,6 +204,10 @@ public:
 
 	// Maximum distance when searching for the nearest nav area during path computation.
 	static constexpr float PATH_GOAL_MAX_DISTANCE_TO_AREA = 200.0f;
+	// Path repair detours are limited to this scale of the straight distance around the blocked areas
+	static constexpr float PATH_REPAIR_MAX_DETOUR_SCALE = 4.0f;
+	// Minimum path repair detour length
+	static constexpr float PATH_REPAIR_MIN_DETOUR_LENGTH = 1024.0f;
 
 	/**
 	 * @brief Finds a path via A* search
@@ -236,6 +269,23 @@ public:
 			TheNavMesh->GetGroundHeight(endPos, &endPos.z);
 		}
 
+		// Bots with the same movement capabilities going between the same areas can share a path
+		std::uint64_t costKey = 0U;
+		const bool useCache = goalArea != nullptr && maxPathLength <= 0.0f && CNavPathCache::IsEnabled() && costFunc.GetCacheKey(costKey);
+		int dangerTeam = NAV_TEAM_ANY;
+		const unsigned int dangerEpoch = costFunc.IsDangerSensitive(dangerTeam) ? TheNavMesh->GetDangerMap().GetEpoch(dangerTeam) : 0U;
+
+		if (useCache)
+		{
+			std::vector<PathArea> chain;
+
+			if (GetCachedPath(bot, startArea, goalArea, costKey, dangerEpoch, chain))
+			{
+				m_pathEndPos = endPos;
+				return BuildPathFromAreas(bot, chain);
+			}
+		}
+
 		// Compute the shorest path
 		CNavArea* closestArea = nullptr;
 		bool pathBuildResult = NavAreaBuildPath(startArea, goalArea, &goal, costFunc, &closestArea, maxPathLength, bot->GetCurrentTeamIndex());
@@ -295,10 +345,23 @@ public:
 
 			segment->area = area;
 			segment->how = area->GetParentHow();
+
+			// only complete paths can be repaired
+			if (pathBuildResult)
+			{
+				m_pathAreas.push_back({ area, area->GetParentHow() });
+			}
 		}
 
 		// Place the path start at the vector start
 		std::reverse(m_segments.begin(), m_segments.end());
+		std::reverse(m_pathAreas.begin(), m_pathAreas.end());
+		m_pathEndPos = endPos;
+
+		if (useCache && pathBuildResult && closestArea == goalArea)
+		{
+			TheNavMesh->GetPathCache().Store(startArea, goalArea, bot->GetCurrentTeamIndex(), costKey, TheNavMesh->GetConnectivityEpoch(), dangerEpoch, closestArea->GetTotalCost(), m_pathAreas);
+		}
 
 		if (!ProcessCurrentPath(bot, start))
 		{
@@ -359,9 +422,106 @@ public:
 			TheNavMesh->GetGroundHeight(endPos, &endPos.z);
 		}
 
+		if (goalArea != nullptr)
+		{
+			return NavAreaIsReachableBidirectional(startArea, goalArea, costFunc, maxPathLength, bot->GetCurrentTeamIndex());
+		}
+
 		return NavAreaBuildPath(startArea, goalArea, &goal, costFunc, nullptr, maxPathLength, bot->GetCurrentTeamIndex());
 	}
 
+	/**
+	 * @brief Repairs the current path when areas ahead of the bot are blocked (IE: a door closed).
+	 * 
+	 * The path before the blocked areas and after them is kept, only a detour from the last good area to the first good area
+	 * after the blocked ones is searched. The goal isn't resolved again.
+	 * @tparam CostFunction Path cost function
+	 * @param bot The bot that will traverse this path
+	 * @param costFunc cost function
+	 * @return True if the path is still valid or was repaired. False if a new path must be computed.
+	 */
+	template <typename CostFunction>
+	bool RepairPath(CBaseBot* bot, CostFunction& costFunc)
+	{
+		if (!IsValid() || m_pathAreas.size() < 2U || !bot->GetMovementInterface()->IsPathingAllowed())
+		{
+			return false;
+		}
+
+		CNavArea* startArea = bot->GetLastKnownNavArea();
+		std::size_t current = m_pathAreas.size();
+
+		for (std::size_t i = 0; i < m_pathAreas.size(); i++)
+		{
+			if (m_pathAreas[i].area == startArea)
+			{
+				current = i;
+				break;
+			}
+		}
+
+		if (current == m_pathAreas.size())
+		{
+			return false; // bot left the path
+		}
+
+		IMovement* mover = bot->GetMovementInterface();
+		std::size_t blocked = current + 1U;
+
+		while (blocked < m_pathAreas.size() && mover->IsAreaTraversable(m_pathAreas[blocked].area))
+		{
+			blocked++;
+		}
+
+		if (blocked == m_pathAreas.size())
+		{
+			return true; // nothing to repair
+		}
+
+		std::size_t rejoin = blocked + 1U;
+
+		while (rejoin < m_pathAreas.size() && !mover->IsAreaTraversable(m_pathAreas[rejoin].area))
+		{
+			rejoin++;
+		}
+
+		if (rejoin == m_pathAreas.size())
+		{
+			return false; // the goal is blocked, let a full search find the closest area
+		}
+
+		CNavArea* from = m_pathAreas[blocked - 1U].area;
+		CNavArea* to = m_pathAreas[rejoin].area;
+		const float maxLength = std::max(PATH_REPAIR_MIN_DETOUR_LENGTH, (to->GetCenter() - from->GetCenter()).Length() * PATH_REPAIR_MAX_DETOUR_SCALE);
+
+		if (!NavAreaBuildPath(from, to, nullptr, costFunc, nullptr, maxLength, bot->GetCurrentTeamIndex()))
+		{
+			return false;
+		}
+
+		std::vector<PathArea> chain;
+		chain.reserve(m_pathAreas.size());
+		chain.insert(chain.end(), m_pathAreas.begin() + current, m_pathAreas.begin() + blocked);
+		const std::size_t detourStart = chain.size();
+
+		for (CNavArea* area = to; area != nullptr && area != from; area = area->GetParent())
+		{
+			chain.push_back({ area, area->GetParentHow() });
+		}
+
+		std::reverse(chain.begin() + detourStart, chain.end());
+		chain.insert(chain.end(), m_pathAreas.begin() + rejoin + 1U, m_pathAreas.end());
+
+		if (!BuildPathFromAreas(bot, chain))
+		{
+			return false;
+		}
+
+		// the search only covered the detour, measure the spliced path instead
+		SetTravelDistance(GetPathLength());
+		return true;
+	}
+
 	virtual void Draw(const BotPathSegment* start, const float duration = 0.1f);
 	virtual void DrawFullPath(const float duration = 0.1f);
 	virtual float GetPathLength() const;
@@ -385,7 +545,7 @@ public:
 	const BotPathSegment* GetLastSegment() const;
 	const BotPathSegment* GetNextSegment(const BotPathSegment* current) const;
 	const BotPathSegment* GetPriorSegment(const BotPathSegment* current) const;
-	inline const std::vector<BotPathSegment>& GetAllPathSegments() const { return m_segments; }
+	inline const SegmentVector& GetAllPathSegments() const { return m_segments; }
 	/**
 	 * @brief Returns the first segment of the given type.
 	 * @param type Type to search.
@@ -474,12 +634,16 @@ protected:
 	bool ProcessOffMeshConnectionsInPath(CBaseBot* bot, const size_t index, BotPathSegment* from, BotPathSegment* to, std::stack<PathInsertSegmentInfo>& pathinsert);
 	void ComputeAreaCrossing(CBaseBot* bot, CNavArea* from, const Vector& frompos, CNavArea* to, NavDirType dir, Vector* crosspoint);
 	void PostProcessPath(CBaseBot* bot);
+	// Moves ground area crossings inside their portals to form straight lines between path corners
+	void StringPullPath(CBaseBot* bot);
+	bool IsStringPullable(const size_t index) const;
+	void StringPullSegments(const size_t first, const size_t last, const float shrink);
 	void CentralizeAreaCrossing(CBaseBot* bot, const Vector& frompos, CNavArea* to, Vector* crosspoint);
-	inline std::vector<BotPathSegment>& GetAllSegments() { return m_segments; }
+	inline SegmentVector& GetAllSegments() { return m_segments; }
 	bool BuildTrivialPath(const Vector& start, const Vector& goal);
 	void SetTravelDistance(const float dist) { m_travelDistance = dist; }
 	CountdownTimer* InternalGetRepathTimer() { return &m_repathTimer; }
-	std::vector<BotPathSegment>::iterator GetSegmentIterator(const BotPathSegment* segment)
+	SegmentVector::iterator GetSegmentIterator(const BotPathSegment* segment)
 	{
 		for (auto it = m_segments.begin(); it != m_segments.end(); it++)
 		{
@@ -492,22 +656,31 @@ protected:
 		return m_segments.end();
 	}
 private:
-	std::vector<BotPathSegment> m_segments;
+	using PathArea = CNavPathCache::PathArea;
+
+	SegmentVector m_segments;
+	std::vector<PathArea> m_pathAreas; // area chain of the last complete path, used for repairs
+	Vector m_pathEndPos; // path end position on the ground
 	IntervalTimer m_ageTimer;
 	PathCursor m_cursor;
 	float m_cursorPos;
 	Vector m_destination; // 'Goal' position of the last ComputePath call
-	float m_travelDistance; // Travel distance between start and goal from the last ComputePath Call
+	float m_travelDistance; // Travel distance between start and goal from the last ComputePath or RepairPath Call
 	CountdownTimer m_repathTimer;
 
 	void DrawSingleSegment(const Vector& v1, const Vector& v2, AIPath::SegmentType type, const float duration);
 	void Drawladder(const CNavLadder* ladder, AIPath::SegmentType type, const float duration);
 	void CheckDropDownsForGapJumps(const CBaseBot* bot, BotPathSegment* from, BotPathSegment* dropStart, BotPathSegment* dropEnd) const;
+	// Builds the path segments from an area chain, used by path repairs
+	bool BuildPathFromAreas(CBaseBot* bot, std::vector<PathArea>& chain);
+	// Copies a cached area chain that is still traversable by the bot, sets the travel distance
+	bool GetCachedPath(CBaseBot* bot, CNavArea* startArea, CNavArea* goalArea, std::uint64_t costKey, unsigned int dangerEpoch, std::vector<PathArea>& chain);
 };
 
 inline void CPath::Invalidate()
 {
 	m_segments.clear();
+	m_pathAreas.clear();
 	m_ageTimer.Invalidate();
 	m_cursorPos = 0.0f;
 	m_cursor.Invalidate();
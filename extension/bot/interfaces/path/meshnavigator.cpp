@@ -2,6 +2,7 @@
 #include <util/gamedata_const.h>
 #include <mods/basemod.h>
 #include <entities/baseentity.h>
+#include <util/hotpath_profiler.h>
 #include "meshnavigator.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -16,6 +17,7 @@ static ConVar sm_navbot_path_debug_climbing("sm_navbot_path_debug_climbing", "0"
 static ConVar sm_navbot_path_goal_tolerance("sm_navbot_path_goal_tolerance", "32", FCVAR_DONTRECORD, "Default navigator goal tolerance");
 static ConVar sm_navbot_path_skip_ahead_distance("sm_navbot_path_skip_ahead_distance", "350", FCVAR_DONTRECORD, "Default navigator skip ahead distance");
 static ConVar sm_navbot_path_obstacle_scan("sm_navbot_path_obstacle_scan", "0.5", FCVAR_DONTRECORD, "How frequently the navigation will scan for obstacles on the bot's path.");
+static ConVar sm_navbot_path_clearance_cache("sm_navbot_path_clearance_cache", "1", FCVAR_DONTRECORD, "If enabled, obstacle traces are skipped on path segments free of world geometry when there are no solid entities nearby.");
 static ConVar sm_navbot_path_break_enemy_visible("sm_navbot_path_break_enemy_visible", "1", FCVAR_DONTRECORD, "If enabled (default), bots will break obstacles while enemies are visible.");
 
 #ifdef EXT_DEBUG
@@ -23,6 +25,33 @@ static ConVar sm_navbot_path_debug_goal("sm_navbot_path_debug_goal", "0", FCVAR_
 #endif // EXT_DEBUG
 
 
+// Partition enumerator that stops at the first solid entity that isn't the bot
+class CNearbySolidEntityEnumerator : public IPartitionEnumerator
+{
+public:
+	CNearbySolidEntityEnumerator(CBaseEntity* me) :
+		m_me(me), m_found(false)
+	{
+	}
+
+	IterationRetval_t EnumElement(IHandleEntity* pHandleEntity) override
+	{
+		if (trace::EntityFromEntityHandle(pHandleEntity) == m_me)
+		{
+			return ITERATION_CONTINUE;
+		}
+
+		m_found = true;
+		return ITERATION_STOP;
+	}
+
+	bool FoundAny() const { return m_found; }
+
+private:
+	CBaseEntity* m_me;
+	bool m_found;
+};
+
 CMeshNavigator::CMeshNavigator() : CPath()
 {
 	float goaltolerance = sm_navbot_path_goal_tolerance.GetFloat();
@@ -107,6 +136,8 @@ void CMeshNavigator::Update(CBaseBot* bot)
 	VPROF_BUDGET("CMeshNavigator::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CMeshNavigator::Update");
+
 	if (!IsValid() || m_goal == nullptr)
 	{
 		return; // no path or goal
@@ -158,7 +189,7 @@ void CMeshNavigator::Update(CBaseBot* bot)
 
 	if (m_obstacleScanTimer.IsElapsed())
 	{
-		m_obstacleScanTimer.Start(sm_navbot_path_obstacle_scan.GetFloat());
+		m_obstacleScanTimer.Start(sm_navbot_path_obstacle_scan.GetFloat() * bot->GetLOD().GetScanIntervalScale());
 
 		if (CheckForObstacles(bot, m_goal))
 		{
@@ -264,7 +295,8 @@ void CMeshNavigator::Update(CBaseBot* bot)
 	if (rangeToGoal > nearLedgeRange || (m_goal && m_goal->type != AIPath::SegmentType::SEGMENT_CLIMB_UP && m_goal->type != AIPath::SegmentType::SEGMENT_CLIMB_DOUBLE_JUMP))
 	{
 		auto next = GetNextSegment(m_goal);
-		bool shouldavoid = true;
+		// bots far away from humans skip the avoidance traces and move straight to the segment goal
+		bool shouldavoid = !bot->GetLOD().IsAtLeast(CBotLOD::Level::LOD_REDUCED);
 
 		constexpr auto nearLadderRange = 55.0f; // avoid range is 50.0f * model scale. Most of the time the model scale will be 1.0f
 
@@ -615,8 +647,20 @@ const BotPathSegment* CMeshNavigator::CheckSkipPath(CBaseBot* bot, const BotPath
 					break; // movement interface disallows skipping the next segment area
 				}
 
-				if (mover->IsPotentiallyTraversable(origin, next->goal, nullptr, false) && 
-					mover->HasPotentialGap(origin, next->goal, nullptr) == false)
+				// string pulled segments on the same straight line as the current goal are reachable without traces, but only if the bot
+				// is on that line. The current goal may be a corner the bot hasn't reached yet.
+				bool onStraightLine = false;
+
+				if (from->straight && next->straight && (skip == from || skip->straight))
+				{
+					Vector close;
+					CalcClosestPointOnLineSegment(origin, from->goal, next->goal, close);
+					const float tolerance = mover->GetHullWidth() * 0.5f;
+					onStraightLine = (close.AsVector2D() - origin.AsVector2D()).LengthSqr() <= tolerance * tolerance;
+				}
+
+				if (onStraightLine || (mover->IsPotentiallyTraversable(origin, next->goal, nullptr, false) && 
+					mover->HasPotentialGap(origin, next->goal, nullptr) == false))
 				{
 					// only skip a segment if the bot is able to move directly to it from it's current position
 					// and there isn't any holes on the ground
@@ -668,6 +712,8 @@ bool CMeshNavigator::CheckForObstacles(CBaseBot* bot, const BotPathSegment* goal
 #ifdef EXT_VPROF_ENABLED
 	VPROF_BUDGET("CMeshNavigator::CheckForObstacles", "NavBot");
 #endif // EXT_VPROF_ENABLED
+
+	NAVBOT_PROFILE_SCOPE("CMeshNavigator::CheckForObstacles");
 	IMovement* mover = bot->GetMovementInterface();
 	Vector origin = bot->GetAbsOrigin();
 	Vector forward = (goal->goal - origin);
@@ -687,6 +733,20 @@ bool CMeshNavigator::CheckForObstacles(CBaseBot* bot, const BotPathSegment* goal
 
 	EXT_ASSERT(maxs.z >= 1.0f, "Bad Maxs Z value!");
 
+	// only entities are handled here, skip the trace if there isn't any near the sweep
+	if (sm_navbot_path_clearance_cache.GetBool())
+	{
+		Vector boxmins = origin + mins;
+		Vector boxmaxs = origin + maxs;
+		boxmins = boxmins.Min(end + mins);
+		boxmaxs = boxmaxs.Max(end + maxs);
+
+		if (!HasSolidEntitiesNearby(bot, boxmins, boxmaxs))
+		{
+			return false;
+		}
+	}
+
 	// check if there is a potential obstacle ahead
 	trace::hull(origin, end, mins, maxs, mask, &filter, tr);
 
@@ -776,6 +836,64 @@ bool CMeshNavigator::CheckForObstacles(CBaseBot* bot, const BotPathSegment* goal
 	return false;
 }
 
+bool CMeshNavigator::IsSegmentStaticallyClear(CBaseBot* bot, const BotPathSegment* segment) const
+{
+	const BotPathSegment* prior = GetPriorSegment(segment);
+
+	if (!prior)
+	{
+		return false;
+	}
+
+	IMovement* mover = bot->GetMovementInterface();
+
+	if (segment->clearance == BotPathSegment::Clearance::UNKNOWN)
+	{
+		segment->clearance = BotPathSegment::Clearance::BLOCKED;
+
+		// only straight ground corridors
+		if (segment->type == AIPath::SegmentType::SEGMENT_GROUND && segment->ladder == nullptr && prior->ladder == nullptr)
+		{
+			Vector forward = segment->goal - prior->goal;
+			forward.z = 0.0f;
+			forward.NormalizeInPlace();
+
+			// covers both avoid traces plus the distance the bot is allowed to be away from the segment line
+			const float halfWidth = mover->GetHullWidth() + 2.0f;
+			const Vector mins(-halfWidth, -halfWidth, (mover->GetStepHeight() * 0.5f) + 0.1f);
+			const Vector maxs(halfWidth, halfWidth, mover->GetCrouchedHullHeight());
+			const Vector end = segment->goal + (forward * (mover->GetAvoidDistance() * bot->GetModelScale()));
+			CTraceFilterWorldOnly filter;
+			trace_t tr;
+			trace::hull(prior->goal, end, mins, maxs, mover->GetMovementTraceMask(), &filter, tr);
+
+			if (!tr.startsolid && tr.fraction >= 1.0f)
+			{
+				segment->clearance = BotPathSegment::Clearance::CLEAR;
+			}
+		}
+	}
+
+	if (segment->clearance != BotPathSegment::Clearance::CLEAR)
+	{
+		return false;
+	}
+
+	const Vector& origin = bot->GetAbsOrigin();
+	Vector close;
+	CalcClosestPointOnLineSegment(origin, prior->goal, segment->goal, close);
+	const float tolerance = mover->GetHullWidth() * 0.5f;
+
+	return (origin.AsVector2D() - close.AsVector2D()).IsLengthLessThan(tolerance) && std::abs(origin.z - close.z) <= mover->GetStepHeight();
+}
+
+bool CMeshNavigator::HasSolidEntitiesNearby(CBaseBot* bot, const Vector& mins, const Vector& maxs) const
+{
+	CNearbySolidEntityEnumerator enumerator(bot->GetEntity());
+	partition->EnumerateElementsInBox(PARTITION_ENGINE_SOLID_EDICTS, mins, maxs, false, &enumerator);
+	return enumerator.FoundAny();
+}
+
 void CMeshNavigator::UseEntity(CBaseBot* bot, CBaseEntity* entity, const float time)
 {
 	if (!m_useEntityCooldown.IsElapsed()) { return; }
@@ -1471,6 +1589,8 @@ Vector CMeshNavigator::Avoid(CBaseBot* bot, const Vector& goalPos, const Vector&
 	VPROF_BUDGET("CMeshNavigator::Avoid", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CMeshNavigator::Avoid");
+
 	if (!m_avoidTimer.IsElapsed())
 	{
 		return goalPos;
@@ -1514,6 +1634,23 @@ Vector CMeshNavigator::Avoid(CBaseBot* bot, const Vector& goalPos, const Vector&
 		return goalPos;
 	}
 
+	if (sm_navbot_path_clearance_cache.GetBool() && m_goal && IsSegmentStaticallyClear(bot, m_goal))
+	{
+		// the world around the segment is clear, only entities can block the bot here
+		const float reach = mover->GetHullWidth() + (mover->GetAvoidDistance() * bot->GetModelScale());
+		const Vector boxmins(botorigin.x - reach, botorigin.y - reach, botorigin.z);
+		const Vector boxmaxs(botorigin.x + reach, botorigin.y + reach, botorigin.z + mover->GetCrouchedHullHeight());
+
+		if (!HasSolidEntitiesNearby(bot, boxmins, boxmaxs))
+		{
+			m_avoidIsLeftClear = true;
+			m_avoidIsRightClear = true;
+			m_avoidLeftEntity = nullptr;
+			m_avoidRightEntity = nullptr;
+			return goalPos;
+		}
+	}
+
 	m_didAvoidCheck = true;
 
 	trace_t result;
@@ -72,6 +72,22 @@ protected:
 	 * @return Return true to return early in the navigator update function. False to continue the function.
 	 */
 	bool CheckForObstacles(CBaseBot* bot, const BotPathSegment* goal);
+	/**
+	 * @brief Checks if the bot is moving along a segment with a corridor free of world geometry.
+	 * The world trace is done once per segment and cached in the segment.
+	 * @param bot Bot currently using this navigator.
+	 * @param segment Segment to check.
+	 * @return True if the segment is clear and the bot is close to the segment line.
+	 */
+	bool IsSegmentStaticallyClear(CBaseBot* bot, const BotPathSegment* segment) const;
+	/**
+	 * @brief Checks if there are solid entities other than the bot inside the given box using the engine's spatial partition.
+	 * @param bot Bot to ignore.
+	 * @param mins Box mins (world space).
+	 * @param maxs Box maxs (world space).
+	 * @return True if at least one solid entity was found.
+	 */
+	bool HasSolidEntitiesNearby(CBaseBot* bot, const Vector& mins, const Vector& maxs) const;
 	/**
 	 * @brief Instructs the navigator to +USE an entity on the bot's path.
 	 * @param bot Bot that will +USE the entity.
@@ -161,6 +177,9 @@ private:
 class CMeshNavigatorAutoRepath : public CMeshNavigator
 {
 public:
+	// While the goal doesn't change, paths are repaired instead of computed again. A full path search still runs at this interval.
+	static constexpr float FULL_REPATH_INTERVAL = 5.0f;
+
 	CMeshNavigatorAutoRepath(float repathInterval = 1.0f)
 	{
 		m_repathinterval = repathInterval;
@@ -185,6 +204,7 @@ public:
 private:
 	float m_repathinterval;
 	CountdownTimer m_failTimer; // Time to wait if the path failed
+	CountdownTimer m_fullRepathTimer; // Time until the next full path search
 	Vector m_lastGoal; // goal from the last valid path
 	int m_failCount; // number of times it failed to build a path
 
@@ -240,21 +260,27 @@ inline void CMeshNavigatorAutoRepath::RefreshPath(CBaseBot* bot, const Vector& g
 		return;
 	}
 
-	if (!IsValid() || IsRepathNeeded(goal))
+	// Same goal, repair the current path around blocked areas instead of searching from scratch
+	if (IsValid() && !IsRepathNeeded(goal) && !m_fullRepathTimer.IsElapsed() && this->RepairPath<CF>(bot, costFunctor))
+	{
+		repathtimer->Start(m_repathinterval);
+		return;
+	}
+
+	bool foundpath = this->ComputePathToPosition<CF>(bot, goal, costFunctor);
+
+	if (!foundpath)
+	{
+		Invalidate();
+		m_failTimer.Start(1.0f); // Wait one second before repath
+		m_failCount++;
+		bot->OnMoveToFailure(this, IEventListener::MovementFailureType::FAIL_NO_PATH);
+	}
+	else
 	{
-		bool foundpath = this->ComputePathToPosition<CF>(bot, goal, costFunctor);
-
-		if (!foundpath)
-		{
-			Invalidate();
-			m_failTimer.Start(1.0f); // Wait one second before repath
-			m_failCount++;
-			bot->OnMoveToFailure(this, IEventListener::MovementFailureType::FAIL_NO_PATH);
-		}
-		else
-		{
-			repathtimer->Start(m_repathinterval);
-		}
+		repathtimer->Start(m_repathinterval);
+		m_fullRepathTimer.Start(FULL_REPATH_INTERVAL);
+		m_lastGoal = goal;
 	}
 }
 
@@ -257,8 +257,17 @@ void IPlayerController::RunLook()
 		m_isOnTarget = false; // aim is off target
 	}
 
-	finalAngles.x = ApproachAngle(desiredAngles.x, currentAngles.x, m_aimSpeed * deltaTime);
-	finalAngles.y = ApproachAngle(desiredAngles.y, currentAngles.y, m_aimSpeed * deltaTime);
+	if (me->GetLOD().IsAtLeast(CBotLOD::Level::LOD_MINIMAL))
+	{
+		// no humans nearby to notice, skip aim smoothing
+		finalAngles.x = desiredAngles.x;
+		finalAngles.y = desiredAngles.y;
+	}
+	else
+	{
+		finalAngles.x = ApproachAngle(desiredAngles.x, currentAngles.x, m_aimSpeed * deltaTime);
+		finalAngles.y = ApproachAngle(desiredAngles.y, currentAngles.y, m_aimSpeed * deltaTime);
+	}
 
 	finalAngles.x = AngleNormalize(finalAngles.x);
 	finalAngles.y = AngleNormalize(finalAngles.y);
@@ -13,6 +13,7 @@
 #include <sdkports/sdk_traces.h>
 #include <sdkports/debugoverlay_shared.h>
 #include <sdkports/sdk_takedamageinfo.h>
+#include <util/hotpath_profiler.h>
 #include "sensor.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -78,6 +79,7 @@ ISensor::ISensor(CBaseBot* bot) : IBotInterface(bot)
 	m_maxhearingrange = static_cast<float>(profile->GetMaxHearingRange());
 	m_minrecognitiontime = profile->GetMinRecognitionTime();
 	m_lastupdatetime = 0.0f;
+	m_lodSkippedUpdates = 0;
 	m_primarythreatcache = nullptr;
 	m_cachedNPCupdaterate = extmanager->GetMod()->GetModSettings()->GetVisionNPCUpdateRate();
 	m_updateStatisticsTimer.Start(extmanager->GetMod()->GetModSettings()->GetVisionStatisticsUpdateRate());
@@ -193,6 +195,7 @@ void ISensor::Reset()
 {
 	m_knownlist.clear();
 	m_lastupdatetime = 0.0f;
+	m_lodSkippedUpdates = 0;
 	m_reportKnownsTimer.Start(ISensor::UPDATE_SHARED_MEMORY_FREQ);
 	m_updateStatisticsTimer.Reset();
 	m_primarythreatoverride.reset(nullptr);
@@ -210,6 +213,8 @@ void ISensor::Update()
 	VPROF_BUDGET("ISensor::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISensor::Update");
+
 	UpdateKnownEntities();
 
 	if (m_reportKnownsTimer.IsElapsed())
@@ -840,16 +845,28 @@ void ISensor::UpdateKnownEntities()
 	VPROF_BUDGET("ISensor::UpdateKnownEntities", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
-	std::vector<CBaseEntity*> potentiallyVisible;
-	potentiallyVisible.reserve(1024);
+	NAVBOT_PROFILE_SCOPE("ISensor::UpdateKnownEntities");
 
-	if (cvar_navbot_notarget.GetInt() == 0)
+	// Bots far away from humans collect visible entities less often, the known list is still maintained every update
+	if (m_lodSkippedUpdates < GetBot<CBaseBot>()->GetLOD().GetSensorUpdateSkips())
 	{
-		CollectPlayers(potentiallyVisible);
-		CollectNonPlayerEntities(potentiallyVisible);
+		m_lodSkippedUpdates++;
+		MaintainKnownEntities();
 	}
+	else
+	{
+		m_lodSkippedUpdates = 0;
+		std::vector<CBaseEntity*> potentiallyVisible;
+		potentiallyVisible.reserve(1024);
+
+		if (cvar_navbot_notarget.GetInt() == 0)
+		{
+			CollectPlayers(potentiallyVisible);
+			CollectNonPlayerEntities(potentiallyVisible);
+		}
 
-	UpdateVisibleEntities(potentiallyVisible);
+		UpdateVisibleEntities(potentiallyVisible);
+	}
 
 	if (m_updateStatisticsTimer.IsElapsed())
 	{
@@ -883,6 +900,8 @@ void ISensor::UpdateVisibleEntities(const std::vector<CBaseEntity*>& potentially
 	VPROF_BUDGET("ISensor::UpdateVisibleEntities", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISensor::UpdateVisibleEntities");
+
 	CBaseBot* me = GetBot<CBaseBot>();
 
 	// Determine which entities are visible right now.
@@ -915,20 +934,7 @@ void ISensor::UpdateVisibleEntities(const std::vector<CBaseEntity*>& potentially
 			known.UpdateVisibilityStatus(true);
 			knownEntities.insert(pEntity); // remember that this entity is already known by the bot
 
-			// reaction time check
-			if (known.GetTimeSinceBecameVisible() >= GetMinRecognitionTime() && m_lastupdatetime - known.GetTimeWhenBecameVisible() < GetMinRecognitionTime())
-			{
-				me->OnSight(pEntity);
-
-				if (me->IsDebugging(BOTDEBUG_SENSOR))
-				{
-					me->DebugPrintToConsole(0, 128, 0, "%s CAUGHT LINE OF SIGHT WITH %s\n",
-						me->GetDebugIdentifier(), UtilHelpers::textformat::FormatEntity(pEntity));
-
-					NDebugOverlay::HorzArrow(me->GetEyeOrigin(), UtilHelpers::getWorldSpaceCenter(pEntity), 2.0f, 0, 255, 0, 255, false, 5.0f);
-				}
-			}
-
+			CheckRecognitionTime(known);
 			UpdateSinceVisibleTime(modhelpers->GetEntityTeamNumber(pEntity));
 		}
 		else
@@ -970,13 +976,82 @@ void ISensor::UpdateVisibleEntities(const std::vector<CBaseEntity*>& potentially
 	});
 }
 
+void ISensor::MaintainKnownEntities()
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("ISensor::MaintainKnownEntities", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	NAVBOT_PROFILE_SCOPE("ISensor::MaintainKnownEntities");
+
+	for (auto it = m_knownlist.begin(); it != m_knownlist.end();)
+	{
+		CKnownEntity& known = *it;
+
+		if (known.IsObsolete())
+		{
+			it = m_knownlist.erase(it);
+			continue;
+		}
+
+		// visibility is kept from the last vision update
+		if (known.IsVisibleNow())
+		{
+			CheckRecognitionTime(known);
+		}
+
+		it++;
+	}
+}
+
+void ISensor::CheckRecognitionTime(const CKnownEntity& known)
+{
+	// reaction time check
+	if (known.GetTimeSinceBecameVisible() >= GetMinRecognitionTime() && m_lastupdatetime - known.GetTimeWhenBecameVisible() < GetMinRecognitionTime())
+	{
+		CBaseBot* me = GetBot<CBaseBot>();
+		CBaseEntity* pEntity = known.GetEntity();
+		me->OnSight(pEntity);
+
+		if (me->IsDebugging(BOTDEBUG_SENSOR))
+		{
+			me->DebugPrintToConsole(0, 128, 0, "%s CAUGHT LINE OF SIGHT WITH %s\n",
+				me->GetDebugIdentifier(), UtilHelpers::textformat::FormatEntity(pEntity));
+
+			NDebugOverlay::HorzArrow(me->GetEyeOrigin(), UtilHelpers::getWorldSpaceCenter(pEntity), 2.0f, 0, 255, 0, 255, false, 5.0f);
+		}
+	}
+}
+
 void ISensor::CollectPlayers(std::vector<CBaseEntity*>& visibleVec)
 {
 #ifdef EXT_VPROF_ENABLED
 	VPROF_BUDGET("ISensor::CollectPlayers", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISensor::CollectPlayers");
+
 	const int myindex = GetBot<CBaseBot>()->GetIndex();
+	// players in vision range computed by the think pipeline at the end of the last frame
+	const std::vector<int>* candidates = extmanager->GetBotThinkPipeline().GetVisionCandidates(myindex);
+
+	if (candidates != nullptr)
+	{
+		for (int i : *candidates)
+		{
+			CBaseEntity* entity = gamehelpers->ReferenceToEntity(i);
+
+			if (!entity) { continue; }
+
+			if (!modhelpers->IsPlayableTeam(modhelpers->GetEntityTeamNumber(entity))) { continue; }
+
+			if (IsIgnored(entity)) { continue; }
+
+			visibleVec.push_back(entity);
+		}
+
+		return;
+	}
 
 	for (int i = 1; i <= gpGlobals->maxClients; i++)
 	{
@@ -1004,6 +1079,8 @@ void ISensor::CollectNonPlayerEntities(std::vector<CBaseEntity*>& visibleVec)
 	VPROF_BUDGET("ISensor::CollectNonPlayerEntities", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISensor::CollectNonPlayerEntities");
+
 	for (auto& handle : ISensor::s_npcentities)
 	{
 		CBaseEntity* pEntity = handle.Get();
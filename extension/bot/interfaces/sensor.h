@@ -8,6 +8,7 @@
 #include <sdkports/sdk_timers.h>
 #include <bot/interfaces/base_interface.h>
 #include <bot/interfaces/knownentity.h>
+#include <util/memory_tracker.h>
 #include <bspfile.h>
 
 class CNavArea;
@@ -20,8 +21,11 @@ public:
 	ISensor(CBaseBot* bot);
 	~ISensor() override;
 
+	using KnownEntityList = std::vector<CKnownEntity, memtracker::TrackedAllocator<CKnownEntity, memtracker::Category::KNOWN_ENTITIES>>;
+
 	void OnInjured(const CTakeDamageInfo& info) override;
 	void OnSound(CBaseEntity* source, const Vector& position, IEventListener::SoundType type, const float maxRadius) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_INJURED) | EventBit(EVENT_SOUND); }
 
 	static inline std::array<byte, MAX_MAP_CLUSTERS / 8> s_pvs{};
 	static constexpr float UPDATE_SHARED_MEMORY_FREQ = 2.0f; // frequency of shared memory updates
@@ -274,6 +278,13 @@ protected:
 	 * @param visibleVec Vector of entities that are visible to the bot right now.
 	 */
 	virtual void UpdateVisibleEntities(const std::vector<CBaseEntity*>& potentiallyVisible);
+	/**
+	 * @brief Removes obsolete known entities and handles reaction time without running a vision update.
+	 * Used by the AI LOD on updates that skip the vision collection.
+	 */
+	void MaintainKnownEntities();
+	// Calls OnSight if the reaction time for a visible known entity passed since the last update.
+	void CheckRecognitionTime(const CKnownEntity& known);
 	/**
 	 * @brief Collects player entities to test for visibility.
 	 * @param visibleVec Vector to store the player entities.
@@ -297,7 +308,7 @@ protected:
 
 		return nullptr;
 	}
-	inline std::vector<CKnownEntity>& GetKnownEntityList() { return m_knownlist; }
+	inline KnownEntityList& GetKnownEntityList() { return m_knownlist; }
 
 	inline bool IsAwareOf(const CKnownEntity* known) const
 	{
@@ -361,7 +372,7 @@ protected:
 	}
 
 private:
-	std::vector<CKnownEntity> m_knownlist;
+	KnownEntityList m_knownlist;
 	const CKnownEntity* m_primarythreatcache;
 	std::unique_ptr<CKnownEntity> m_primarythreatoverride;
 	CountdownTimer m_updateStatisticsTimer;
@@ -374,6 +385,7 @@ private:
 	float m_maxhearingrange;
 	float m_minrecognitiontime;
 	float m_lastupdatetime;
+	int m_lodSkippedUpdates; // number of known entity updates skipped by the AI LOD
 	int m_statsvisibleallies;
 	int m_statsvisibleenemies;
 	int m_statsknownallies; // total number of known allies (visible or not)
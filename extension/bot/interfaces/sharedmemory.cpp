@@ -7,6 +7,7 @@
 #include <bot/interfaces/path/basepath.h>
 #include <navmesh/nav_mesh.h>
 #include <navmesh/nav_area.h>
+#include <util/hotpath_profiler.h>
 #include "sharedmemory.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -85,6 +86,8 @@ void ISharedBotMemory::Update()
 	VPROF_BUDGET("ISharedBotMemory::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISharedBotMemory::Update");
+
 	UpdateReportedEntities();
 }
 
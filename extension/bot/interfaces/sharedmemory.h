@@ -6,6 +6,7 @@ class CBaseBot;
 class CNavArea;
 
 #include <sdkports/sdk_ehandle.h>
+#include <util/memory_tracker.h>
 
 /**
  * @brief Interface for storing shared information between all bots.
@@ -212,7 +213,7 @@ protected:
 	}
 
 private:
-	std::vector<ReportedEntityData> m_reportedentitiesvec; // Vector of entities reported by bots.
+	std::vector<ReportedEntityData, memtracker::TrackedAllocator<ReportedEntityData, memtracker::Category::SHARED_MEMORY>> m_reportedentitiesvec; // Vector of entities reported by bots.
 	int m_defenders; // number of bots doing defensive tasks
 
 };
@@ -5,6 +5,7 @@
 #include <mods/basemod.h>
 #include <mods/modhelpers.h>
 #include <bot/basebot.h>
+#include <util/hotpath_profiler.h>
 #include "squads.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -154,6 +155,8 @@ void ISquad::Update()
 	VPROF_BUDGET("ISquad::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("ISquad::Update");
+
 	if (!IsInASquad())
 	{
 		return; // not in a squad, do nothing
@@ -234,6 +234,7 @@ public:
 	void Frame() override;
 	void OnKilled(const CTakeDamageInfo& info) override;
 	void OnSquadEvent(SquadEventType evtype) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_KILLED) | EventBit(EVENT_SQUAD_EVENT); }
 
 	// Returns true if the bot is in a squad. (The squad may be in an invalid state).
 	bool IsInASquad() const { return static_cast<bool>(m_data); }
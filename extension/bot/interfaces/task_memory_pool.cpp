@@ -0,0 +1,168 @@
+#include NAVBOT_PCH_FILE
+#include <cstdint>
+#include <algorithm>
+#include <new>
+#include <util/memory_tracker.h>
+#include "task_memory_pool.h"
+
+CTaskMemoryPool::CTaskMemoryPool()
+{
+	for (auto& bucket : m_buckets)
+	{
+		bucket.freelist = nullptr;
+		bucket.live = 0U;
+	}
+
+	m_stats.liveAllocations = 0U;
+	m_stats.liveBytes = 0U;
+	m_stats.reservedBytes = 0U;
+	m_stats.totalAllocations = 0U;
+	m_stats.heapAllocations = 0U;
+
+	GetPools().push_back(this);
+}
+
+CTaskMemoryPool::~CTaskMemoryPool()
+{
+	auto& pools = GetPools();
+	pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+
+	// Tasks still alive at this point are leaked along with their slabs instead of leaving dangling pointers
+	if (m_stats.liveAllocations == 0U)
+	{
+		ReleaseUnused();
+	}
+}
+
+void* CTaskMemoryPool::Allocate(std::size_t size)
+{
+	m_stats.totalAllocations++;
+
+	// every allocation starts with the owner tag of the bot that created the task
+	const std::size_t total = size + memtracker::HEADER_SIZE;
+	const memtracker::OwnerTag tag = memtracker::GetCurrentOwnerTag();
+	std::uint8_t* base = nullptr;
+
+	if (total > MAX_POOLED_SIZE)
+	{
+		m_stats.heapAllocations++;
+		m_stats.liveAllocations++;
+		m_stats.liveBytes += total;
+		memtracker::RecordAllocation(memtracker::Category::TASKS, total, tag);
+		base = static_cast<std::uint8_t*>(::operator new(total));
+	}
+	else
+	{
+		const std::size_t index = GetBucketIndex(total);
+		Bucket& bucket = m_buckets[index];
+
+		if (bucket.freelist == nullptr)
+		{
+			AllocateSlab(index);
+		}
+
+		FreeBlock* block = bucket.freelist;
+		bucket.freelist = block->next;
+		bucket.live++;
+		m_stats.liveAllocations++;
+		m_stats.liveBytes += GetBlockSize(index);
+		memtracker::RecordAllocation(memtracker::Category::TASKS, GetBlockSize(index), tag);
+		base = reinterpret_cast<std::uint8_t*>(block);
+	}
+
+	*reinterpret_cast<memtracker::OwnerTag*>(base) = tag;
+	return base + memtracker::HEADER_SIZE;
+}
+
+void CTaskMemoryPool::Deallocate(void* ptr, std::size_t size)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	std::uint8_t* base = static_cast<std::uint8_t*>(ptr) - memtracker::HEADER_SIZE;
+	const memtracker::OwnerTag tag = *reinterpret_cast<const memtracker::OwnerTag*>(base);
+	const std::size_t total = size + memtracker::HEADER_SIZE;
+
+	m_stats.liveAllocations--;
+
+	if (total > MAX_POOLED_SIZE)
+	{
+		m_stats.liveBytes -= total;
+		memtracker::RecordFree(memtracker::Category::TASKS, total, tag);
+		::operator delete(base);
+		return;
+	}
+
+	const std::size_t index = GetBucketIndex(total);
+	Bucket& bucket = m_buckets[index];
+	FreeBlock* block = reinterpret_cast<FreeBlock*>(base);
+	block->next = bucket.freelist;
+	bucket.freelist = block;
+	bucket.live--;
+	m_stats.liveBytes -= GetBlockSize(index);
+	memtracker::RecordFree(memtracker::Category::TASKS, GetBlockSize(index), tag);
+}
+
+void CTaskMemoryPool::ReleaseUnused()
+{
+	for (std::size_t i = 0U; i < NUM_BUCKETS; i++)
+	{
+		if (m_buckets[i].live == 0U)
+		{
+			ReleaseBucket(m_buckets[i], i);
+		}
+	}
+}
+
+void CTaskMemoryPool::ReleaseAllUnused()
+{
+	for (CTaskMemoryPool* pool : GetPools())
+	{
+		pool->ReleaseUnused();
+	}
+}
+
+std::vector<CTaskMemoryPool*>& CTaskMemoryPool::GetPools()
+{
+	static std::vector<CTaskMemoryPool*> pools;
+	return pools;
+}
+
+void CTaskMemoryPool::AllocateSlab(std::size_t index)
+{
+	Bucket& bucket = m_buckets[index];
+	const std::size_t blockSize = GetBlockSize(index);
+	const std::size_t blocks = std::max(SLAB_SIZE / blockSize, MIN_BLOCKS_PER_SLAB);
+	const std::size_t slabSize = blocks * blockSize;
+	std::uint8_t* slab = static_cast<std::uint8_t*>(::operator new(slabSize));
+
+	bucket.slabs.push_back(slab);
+	m_stats.reservedBytes += slabSize;
+	m_stats.heapAllocations++;
+
+	// link in reverse so blocks are handed out in address order
+	for (std::size_t i = blocks; i > 0U; i--)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1U) * blockSize);
+		block->next = bucket.freelist;
+		bucket.freelist = block;
+	}
+}
+
+void CTaskMemoryPool::ReleaseBucket(Bucket& bucket, std::size_t index)
+{
+	const std::size_t blockSize = GetBlockSize(index);
+	const std::size_t blocks = std::max(SLAB_SIZE / blockSize, MIN_BLOCKS_PER_SLAB);
+
+	for (void* slab : bucket.slabs)
+	{
+		::operator delete(slab);
+		m_stats.reservedBytes -= blocks * blockSize;
+	}
+
+	bucket.slabs.clear();
+	bucket.slabs.shrink_to_fit();
+	bucket.freelist = nullptr;
+}
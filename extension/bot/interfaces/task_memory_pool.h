@@ -0,0 +1,88 @@
+#ifndef __NAVBOT_BOT_TASK_MEMORY_POOL_H_
+#define __NAVBOT_BOT_TASK_MEMORY_POOL_H_
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <vector>
+
+/**
+ * @brief Memory pool for AI tasks.
+ *
+ * Allocations are grouped in buckets by size, each bucket carves fixed size blocks out of large slabs and keeps a free list.
+ * Freed blocks are reused by the next task of a similar size, once the slabs are allocated switching tasks doesn't touch the heap.
+ * Slabs of buckets without live blocks are returned to the heap at map end.
+ * Blocks start with a memory tracker owner tag so task memory is counted per bot.
+ */
+class CTaskMemoryPool
+{
+public:
+	CTaskMemoryPool();
+	~CTaskMemoryPool();
+
+	CTaskMemoryPool(const CTaskMemoryPool&) = delete;
+	CTaskMemoryPool& operator=(const CTaskMemoryPool&) = delete;
+
+	static constexpr std::size_t BUCKET_GRANULARITY = 32U; // bucket block size step
+	static constexpr std::size_t MAX_POOLED_SIZE = 4096U; // larger allocations go straight to the heap
+	static constexpr std::size_t NUM_BUCKETS = MAX_POOLED_SIZE / BUCKET_GRANULARITY;
+	static constexpr std::size_t SLAB_SIZE = 16384U; // bytes allocated at once for a bucket
+	static constexpr std::size_t MIN_BLOCKS_PER_SLAB = 4U;
+
+	struct Stats
+	{
+		std::size_t liveAllocations; // blocks currently in use
+		std::size_t liveBytes; // bytes currently in use (block sizes)
+		std::size_t reservedBytes; // bytes held in slabs
+		std::size_t totalAllocations; // number of Allocate calls
+		std::size_t heapAllocations; // number of allocations that went to the heap (slabs and large blocks)
+	};
+
+	void* Allocate(std::size_t size);
+	void Deallocate(void* ptr, std::size_t size);
+	// Returns the slabs of buckets without live blocks to the heap
+	void ReleaseUnused();
+	const Stats& GetStats() const { return m_stats; }
+
+	// Calls ReleaseUnused on every pool
+	static void ReleaseAllUnused();
+
+	/**
+	 * @brief Runs a function on each task memory pool.
+	 * @tparam T A class with operator() overload with one parameter void (const CTaskMemoryPool* pool).
+	 * @param functor Function to run.
+	 */
+	template <typename T>
+	static void ForEachPool(T& functor)
+	{
+		for (const CTaskMemoryPool* pool : GetPools())
+		{
+			functor(pool);
+		}
+	}
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	struct Bucket
+	{
+		FreeBlock* freelist;
+		std::size_t live;
+		std::vector<void*> slabs;
+	};
+
+	std::array<Bucket, NUM_BUCKETS> m_buckets;
+	Stats m_stats;
+
+	static std::size_t GetBucketIndex(std::size_t size) { return (size + BUCKET_GRANULARITY - 1U) / BUCKET_GRANULARITY - 1U; }
+	static std::size_t GetBlockSize(std::size_t index) { return (index + 1U) * BUCKET_GRANULARITY; }
+	static std::vector<CTaskMemoryPool*>& GetPools();
+
+	void AllocateSlab(std::size_t index);
+	void ReleaseBucket(Bucket& bucket, std::size_t index);
+};
+
+#endif // !__NAVBOT_BOT_TASK_MEMORY_POOL_H_
@@ -15,6 +15,7 @@
 #include "decisionquery.h"
 #include "event_listener.h"
 #include "sharedmemory.h"
+#include "task_memory_pool.h"
 
 // Forward declaration
 template <typename BotClass> class AITask;
@@ -192,6 +193,8 @@ public:
 	virtual ~AITaskManager();
 
 	virtual std::vector<IEventListener*>* GetListenerVector();
+	// Union of the events the running tasks responds to, rebuilt after an update that changed the task tree.
+	EventMask GetEventInterestMask() override { return m_interestMask; }
 
 	bool IsRunningTasks() const { return m_task != nullptr; }
 
@@ -202,7 +205,13 @@ public:
 	const char* GetTaskDebugString() const;
 
 	// Notify that a task has ended, add it to the list of tasks for deallocation
-	void NotifyTaskEnd(AITask<BotClass>* task) { m_taskbin.push_back(task); }
+	void NotifyTaskEnd(AITask<BotClass>* task)
+	{
+		m_taskbin.push_back(task);
+		m_interestMaskDirty = true;
+	}
+	// A task was added to or removed from the task tree
+	void NotifyTaskTreeChanged() { m_interestMaskDirty = true; }
 
 	template <typename Result, auto Func, typename ...Args>
 	inline Result PropagateDecisionQuery(const Result& defaultValue, Args&&... _args)
@@ -367,8 +376,11 @@ private:
 	std::vector<AITask<BotClass>*> m_taskbin; // Trash bin for dead tasks
 	std::vector<IEventListener*> m_listeners; // Event listeners
 	BotClass* m_bot;
+	EventMask m_interestMask; // Events any task in the tree responds to
+	bool m_interestMaskDirty; // A task started or ended since the interest mask was built
 
 	void CleanUpDeadTasks();
+	void UpdateEventInterestMask();
 };
 
 template<typename BotClass>
@@ -380,6 +392,7 @@ inline AITaskManager<BotClass>::AITaskManager(AITask<BotClass>* initialTask)
 	m_bot = nullptr;
 
 	m_listeners.push_back(m_task);
+	UpdateEventInterestMask();
 }
 
 template<typename BotClass>
@@ -425,6 +438,8 @@ inline void AITaskManager<BotClass>::Reset(AITask<BotClass>* task)
 	{
 		m_listeners.push_back(m_task);
 	}
+
+	UpdateEventInterestMask();
 }
 
 template<typename BotClass>
@@ -445,6 +460,12 @@ inline void AITaskManager<BotClass>::Update(BotClass* bot)
 	m_task = m_task->RunTask(bot, this, m_task->ProcessTaskUpdate(bot, this));
 
 	CleanUpDeadTasks();
+
+	// the task tree only changes during updates
+	if (m_interestMaskDirty)
+	{
+		UpdateEventInterestMask();
+	}
 }
 
 template<typename BotClass>
@@ -469,6 +490,20 @@ inline void AITaskManager<BotClass>::CleanUpDeadTasks()
 	m_taskbin.clear();
 }
 
+template<typename BotClass>
+inline void AITaskManager<BotClass>::UpdateEventInterestMask()
+{
+	m_interestMaskDirty = false;
+
+	if (m_task == nullptr)
+	{
+		m_interestMask = EVENTMASK_NONE;
+		return;
+	}
+
+	m_interestMask = m_task->CollectEventInterestMask();
+}
+
 template <typename BotClass>
 class AITask : public IEventListener, public IDecisionQuery
 {
@@ -476,6 +511,15 @@ public:
 	AITask();
 	virtual ~AITask();
 
+	// Tasks are allocated from a memory pool shared by all bots of the same class
+	static void* operator new(std::size_t size) { return GetMemoryPool().Allocate(size); }
+	static void operator delete(void* ptr, std::size_t size) { GetMemoryPool().Deallocate(ptr, size); }
+	static CTaskMemoryPool& GetMemoryPool()
+	{
+		static CTaskMemoryPool s_pool;
+		return s_pool;
+	}
+
 	BotClass* GetBot() const { return m_bot; }
 
 	bool HasStarted() const { return m_hasStarted; }
@@ -630,6 +674,17 @@ public:
 	AITask<BotClass>* GetTaskAboveMe() const { return m_topTask; }
 	AITask<BotClass>* GetTaskBelowMe() const { return m_bottomTask; }
 
+	/**
+	 * @brief Events this task responds to. Tasks that only handle a few events should override this so the task manager
+	 * can skip the events no running task cares about.
+	 * @return Event mask, see IEventListener::EventBit.
+	 */
+	virtual EventMask GetTaskEventInterestMask() const { return EVENTMASK_ALL; }
+	// Event interest of this task and all tasks below and after it
+	EventMask CollectEventInterestMask() const;
+	// Tasks always forward events to the next task, filtering is done by the task manager. See GetTaskEventInterestMask.
+	EventMask GetEventInterestMask() final { return EVENTMASK_ALL; }
+
 protected:
 	/**
 	 * @brief (Experimental) Starts a new Next task for this task.
@@ -1260,6 +1315,24 @@ inline AITask<BotClass>::~AITask()
 	m_listener.clear();
 }
 
+template<typename BotClass>
+inline IEventListener::EventMask AITask<BotClass>::CollectEventInterestMask() const
+{
+	EventMask mask = GetTaskEventInterestMask();
+
+	if (m_bottomTask != nullptr)
+	{
+		mask |= m_bottomTask->CollectEventInterestMask();
+	}
+
+	if (m_nextTask != nullptr)
+	{
+		mask |= m_nextTask->CollectEventInterestMask();
+	}
+
+	return mask;
+}
+
 template<typename BotClass>
 inline const char* AITask<BotClass>::DebugString() const
 {
@@ -1527,6 +1600,7 @@ inline TaskResult<BotClass> AITask<BotClass>::ProcessTaskStart(BotClass* bot, AI
 	m_hasStarted = true;
 	m_bot = bot;
 	m_manager = manager;
+	manager->NotifyTaskTreeChanged();
 
 	if (bot->IsDebugging(BOTDEBUG_TASKS))
 	{
@@ -1603,6 +1677,8 @@ inline TaskResult<BotClass> AITask<BotClass>::ProcessTaskUpdate(BotClass* bot, A
 template<typename BotClass>
 inline void AITask<BotClass>::ProcessTaskEnd(BotClass* bot, AITaskManager<BotClass>* manager, AITask<BotClass>* nextTask)
 {
+	manager->NotifyTaskTreeChanged();
+
 	if (m_hasStarted == false)
 	{
 		return; // we never started anyways
@@ -15,6 +15,7 @@
 #include "weapons/dynamic_priorities.h"
 #include <ITextParsers.h>
 #include <util/entprops_consts.h>
+#include <util/memory_tracker.h>
 #include <bot/interfaces/decisionquery.h>
 #include <bot/interfaces/playerinput.h>
 #include "weapons_shared.h"
@@ -269,7 +270,7 @@ private:
 	DistanceMappedAttackDelay dmad;
 };
 
-class WeaponInfo
+class WeaponInfo : public memtracker::CTrackedObject<memtracker::Category::WEAPON_INFO>
 {
 public:
 	// Random Number used to indicate an invalid weapon slot
@@ -1,5 +1,6 @@
 #include NAVBOT_PCH_FILE
 #include <extension.h>
+#include <util/hotpath_profiler.h>
 #include "pluginbot.h"
 #include "pluginbot_behavior.h"
 
@@ -31,6 +32,7 @@ void CPluginBotBehavior::Reset()
 
 void CPluginBotBehavior::Update()
 {
+	NAVBOT_PROFILE_SCOPE("IBehavior::Update");
 	m_manager->Update(static_cast<CPluginBot*>(GetBot()));
 }
 
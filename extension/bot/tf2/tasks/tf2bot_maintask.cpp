@@ -108,8 +108,7 @@ TaskEventResponseResult<CTF2Bot> CTF2BotMainTask::OnKilled(CTF2Bot* bot, const C
 
 	float danger = isSniper ? CNavArea::ADD_DANGER_SNIPER : CNavArea::ADD_DANGER_KILLED;
 
-	botsharedutils::SpreadDangerToNearbyAreas spread(area, teamID, 600.0f, danger, CNavArea::MAX_DANGER_ONKILLED);
-	spread.Execute();
+	TheNavMesh->GetDangerMap().QueueSpread(area, teamID, 600.0f, danger, CNavArea::MAX_DANGER_ONKILLED);
 
 	return TrySwitchTo(new CTF2BotDeadTask, PRIORITY_MANDATORY, "I am dead!");
 }
@@ -17,6 +17,7 @@ public:
 
 	QueryAnswerType ShouldRetreat(CBaseBot* me) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_INJURED) | EventBit(EVENT_VOICE_COMMAND) | EventBit(EVENT_OBJECT_SAPPED) | EventBit(EVENT_DANGEROUS_ENTITY_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "Tactical"; }
 
 	TaskEventResponseResult<CTF2Bot> OnNavAreaChanged(CTF2Bot* bot, CNavArea* oldArea, CNavArea* newArea) override;
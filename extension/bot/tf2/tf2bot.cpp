@@ -752,6 +752,18 @@ float CTF2BotPathCost::operator()(CNavArea* toArea, CNavArea* fromArea, const CN
 	return cost;
 }
 
+bool CTF2BotPathCost::GetCacheKey(std::uint64_t& key) const
+{
+	if (!IGroundPathCost::GetCacheKey(key))
+	{
+		return false;
+	}
+
+	// flag carriers have their own costs
+	key = CNavPathCache::HashCombine(key, static_cast<std::uint32_t>(m_me->IsCarryingAFlag() ? 1U : 0U));
+	return true;
+}
+
 CTF2TraceFilterIgnoreFriendlyCombatItems::CTF2TraceFilterIgnoreFriendlyCombatItems(CBaseEntity* passEnt, int collisionGroup, const int ignoreTeam) :
 	trace::CTraceFilterSimple(passEnt, collisionGroup), m_ignoreTeam(ignoreTeam)
 {
@@ -250,6 +250,7 @@ public:
 
 	void SetRouteType(RouteType type) override { m_routetype = type; }
 	RouteType GetRouteType() const override { return m_routetype; }
+	bool GetCacheKey(std::uint64_t& key) const override;
 private:
 	CTF2Bot* m_me;
 	RouteType m_routetype;
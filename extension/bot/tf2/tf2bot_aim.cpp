@@ -29,7 +29,7 @@ Vector CTF2BotAimHelper::SelectAimPosition(CTF2Bot* bot, CBaseEntity* entity, ID
 			// Use TF2 exclusive speed and gravity functions
 			data.speed = weapon->GetProjectileSpeed(type);
 			data.gravity = weapon->GetProjectileGravity(type);
-			Vector predicted = pred::IterativeBallisticLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), data, maxiterations);
+			Vector predicted = pred::BallisticLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), data, maxiterations);
 
 			if (!bot->IsLineOfFireClear(predicted))
 			{
@@ -50,7 +50,7 @@ Vector CTF2BotAimHelper::SelectAimPosition(CTF2Bot* bot, CBaseEntity* entity, ID
 			}
 			else
 			{
-				predicted = pred::IterativeProjectileLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), projSpeed, maxiterations);
+				predicted = pred::ProjectileLead(GetShooterPosition(), initialTargetPosition, GetTargetVelocity(), projSpeed, maxiterations);
 			}
 
 			if (!bot->IsLineOfFireClear(predicted))
@@ -100,7 +100,7 @@ Vector CTF2BotAimHelper::SelectAimPosition(CTF2Bot* bot, const Vector& target, b
 			// Use TF2 exclusive speed and gravity functions
 			data.speed = weapon->GetProjectileSpeed(type);
 			data.gravity = weapon->GetProjectileGravity(type);
-			Vector predicted = pred::IterativeBallisticLead(GetShooterPosition(), target, GetTargetVelocity(), data, maxiterations);
+			Vector predicted = pred::BallisticLead(GetShooterPosition(), target, GetTargetVelocity(), data, maxiterations);
 
 			if (!bot->IsLineOfFireClear(predicted))
 			{
@@ -113,7 +113,7 @@ Vector CTF2BotAimHelper::SelectAimPosition(CTF2Bot* bot, const Vector& target, b
 		if (weapon->GetWeaponInfo()->GetAttackInfo(type).IsProjectile())
 		{
 			const float projSpeed = weapon->GetWeaponInfo()->GetAttackInfo(type).GetProjectileSpeed();
-			Vector predicted = pred::IterativeProjectileLead(GetShooterPosition(), target, GetTargetVelocity(), projSpeed, maxiterations);
+			Vector predicted = pred::ProjectileLead(GetShooterPosition(), target, GetTargetVelocity(), projSpeed, maxiterations);
 
 			if (!bot->IsLineOfFireClear(predicted))
 			{
@@ -3,6 +3,7 @@
 #include <bot/interfaces/tasks.h>
 #include <bot/tf2/tasks/tf2bot_maintask.h>
 #include <bot/tf2/tf2bot.h>
+#include <util/hotpath_profiler.h>
 #include "tf2bot_behavior.h"
 
 #ifdef EXT_VPROF_ENABLED
@@ -35,6 +36,8 @@ void CTF2BotBehavior::Update()
 	VPROF_BUDGET("CTF2BotBehavior::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("IBehavior::Update");
+
 	m_manager->Update(GetBot<CTF2Bot>());
 }
 
@@ -17,6 +17,7 @@ public:
 	bool IsFriendly(CBaseEntity* entity) const override;
 	bool IsEnemy(CBaseEntity* entity) const override;
 	void OnTruceChanged(const bool enabled) override;
+	EventMask GetEventInterestMask() override { return ISensor::GetEventInterestMask() | EventBit(EVENT_TRUCE_CHANGED); }
 
 	static void RegisterTF2ConVars();
 
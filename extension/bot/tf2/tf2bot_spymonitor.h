@@ -72,6 +72,7 @@ public:
 	void Frame() override;
 	// Bot touch event
 	void OnContact(CBaseEntity* pOther) override;
+	EventMask GetEventInterestMask() override { return EventBit(EVENT_CONTACT); }
 
 	const KnownSpy& GetKnownSpy(edict_t* spy);
 	const KnownSpy& GetKnownSpy(CBaseEntity* spy);
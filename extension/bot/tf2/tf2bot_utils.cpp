@@ -64,19 +64,14 @@ bool CTF2EngineerBuildableAreaCollector::ShouldCollect(CTFNavArea* area)
 		return false;
 	}
 
-	if (m_avoidSlopes)
+	if (!area->HasBuildableFootprint())
 	{
-		Vector point = area->GetCenter();
-		point.z += 16.0f;
-		Vector normal;
+		return false;
+	}
 
-		if (trace::getgroundnormal(point, normal))
-		{
-			if (normal.z <= 0.98f)
-			{
-				return false;
-			}
-		}
+	if (m_avoidSlopes && area->GetStaticAttributes().GetFlatness() <= 0.98f)
+	{
+		return false;
 	}
 
 	if (m_allowVisCheck && !GetStartArea()->HasTFPathAttributes(CTFNavArea::TFNavPathAttributes::TFNAV_PATH_DYNAMIC_SPAWNROOM) && GetStartArea() != area)
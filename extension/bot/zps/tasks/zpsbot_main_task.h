@@ -21,6 +21,7 @@ public:
 	TaskEventResponseResult<CZPSBot> OnDebugMoveToCommand(CZPSBot* bot, const Vector& moveTo) override;
 	TaskEventResponseResult<CZPSBot> OnKilled(CZPSBot* bot, const CTakeDamageInfo& info) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_DEBUG_MOVE_TO_COMMAND) | EventBit(EVENT_KILLED); }
 	const char* GetName() const override { return "MainTask"; }
 
 private:
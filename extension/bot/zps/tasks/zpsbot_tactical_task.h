@@ -14,6 +14,7 @@ public:
 	TaskEventResponseResult<CZPSBot> OnRoundStateChanged(CZPSBot* bot) override;
 	TaskEventResponseResult<CZPSBot> OnPluginCommand(CZPSBot* bot, IEventListener::PluginCommandTypes type, const IEventListener::PluginCommandData& data) override;
 
+	EventMask GetTaskEventInterestMask() const override { return EventBit(EVENT_INJURED) | EventBit(EVENT_NAV_AREA_CHANGED) | EventBit(EVENT_SOUND) | EventBit(EVENT_ROUND_STATE_CHANGED) | EventBit(EVENT_PLUGIN_COMMAND); }
 	const char* GetName() const override { return "Tactical"; }
 
 private:
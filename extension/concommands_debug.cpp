@@ -17,6 +17,8 @@
 #include <sdkports/sdk_entityoutput.h>
 #include <util/ehandle_edict.h>
 #include <util/prediction.h>
+#include <util/memory_tracker.h>
+#include <bot/interfaces/task_memory_pool.h>
 #include <sm_argbuffer.h>
 #include <am-platform.h>
 
@@ -72,6 +74,72 @@ CON_COMMAND(sm_navbot_info, "Prints information about the extension.")
 	META_CONPRINTF("--- END NavBot Info ---\n");
 }
 
+CON_COMMAND_F(sm_navbot_mem_stats, "Reports NavBot memory usage per subsystem and per bot.", FCVAR_GAMEDLL)
+{
+	// allocation rates are measured between calls of this command
+	static std::array<std::size_t, memtracker::MAX_CATEGORIES> s_lastAllocations{};
+	static double s_lastTime = 0.0;
+
+	const double now = Plat_FloatTime();
+	const double elapsed = s_lastTime > 0.0 ? now - s_lastTime : 0.0;
+	s_lastTime = now;
+	std::size_t totalLive = 0U;
+
+	META_CONPRINT("--- NavBot Memory Stats ---\n");
+	META_CONPRINTF("%-16s %12s %12s %12s %12s %10s\n", "Category", "Live KiB", "Peak KiB", "Allocs", "Frees", "Allocs/s");
+
+	for (std::size_t i = 0U; i < memtracker::MAX_CATEGORIES; i++)
+	{
+		const memtracker::Category category = static_cast<memtracker::Category>(i);
+		const memtracker::CategoryStats stats = memtracker::GetCategoryStats(category);
+		const double rate = elapsed > 0.0 ? static_cast<double>(stats.allocations - s_lastAllocations[i]) / elapsed : 0.0;
+		s_lastAllocations[i] = stats.allocations;
+		totalLive += stats.liveBytes;
+
+		META_CONPRINTF("%-16s %12.2f %12.2f %12zu %12zu %10.2f\n", memtracker::GetCategoryName(category), static_cast<double>(stats.liveBytes) / 1024.0,
+			static_cast<double>(stats.peakBytes) / 1024.0, stats.allocations, stats.frees, rate);
+	}
+
+	META_CONPRINTF("Total Live: %.2f KiB\n", static_cast<double>(totalLive) / 1024.0);
+
+	std::size_t poolIndex = 0U;
+	auto poolfunc = [&poolIndex](const CTaskMemoryPool* pool) {
+		const CTaskMemoryPool::Stats& stats = pool->GetStats();
+		META_CONPRINTF("Task Pool #%zu: %zu live tasks, %.2f KiB in use, %.2f KiB reserved, %zu heap allocations out of %zu\n", poolIndex++,
+			stats.liveAllocations, static_cast<double>(stats.liveBytes) / 1024.0, static_cast<double>(stats.reservedBytes) / 1024.0,
+			stats.heapAllocations, stats.totalAllocations);
+	};
+
+	CTaskMemoryPool::ForEachPool(poolfunc);
+
+	auto botfunc = [](CBaseBot* bot) {
+		const std::uint32_t owner = static_cast<std::uint32_t>(bot->GetIndex());
+		std::size_t live = 0U;
+		std::size_t peak = 0U;
+
+		for (std::size_t i = 0U; i < memtracker::MAX_CATEGORIES; i++)
+		{
+			live += memtracker::GetOwnerLiveBytes(owner, static_cast<memtracker::Category>(i));
+			peak += memtracker::GetOwnerPeakBytes(owner, static_cast<memtracker::Category>(i));
+		}
+
+		META_CONPRINTF("Bot %s: %.2f KiB live, %.2f KiB peak\n", bot->GetDebugIdentifier(), static_cast<double>(live) / 1024.0, static_cast<double>(peak) / 1024.0);
+
+		for (std::size_t i = 0U; i < memtracker::MAX_CATEGORIES; i++)
+		{
+			const memtracker::Category category = static_cast<memtracker::Category>(i);
+			const std::size_t bytes = memtracker::GetOwnerLiveBytes(owner, category);
+
+			if (bytes > 0U)
+			{
+				META_CONPRINTF("    %-16s %.2f KiB\n", memtracker::GetCategoryName(category), static_cast<double>(bytes) / 1024.0);
+			}
+		}
+	};
+
+	extmanager->ForEachBot(botfunc);
+}
+
 CON_COMMAND_F_COMPLETION(sm_navbot_debug_bot_sensor_memory, "Debugs the bot Sensor interface's entity memory.", FCVAR_CHEAT | FCVAR_GAMEDLL, CExtManager::AutoComplete_BotNames)
 {
 	DECLARE_COMMAND_ARGS;
@@ -94,6 +162,90 @@ CON_COMMAND_F_COMPLETION(sm_navbot_debug_bot_sensor_memory, "Debugs the bot Sens
 	bot->GetSensorInterface()->ShowDebugInformation();
 }
 
+CON_COMMAND_F(sm_navbot_debug_nav_area_lookups, "Reports the player last known nav area lookup statistics. Pass 'reset' to clear them.", FCVAR_GAMEDLL)
+{
+	DECLARE_COMMAND_ARGS;
+
+	CBaseExtPlayer::NavAreaLookupStats& stats = CBaseExtPlayer::s_navarealookupstats;
+	const std::uint64_t total = stats.hits + stats.misses;
+	const double hitrate = total > 0U ? (static_cast<double>(stats.hits) / static_cast<double>(total)) * 100.0 : 0.0;
+
+	META_CONPRINTF("Nav area lookups: %llu \n  Hits: %llu \n  Misses: %llu \n  Hit rate: %3.2f%% \n",
+		static_cast<unsigned long long>(total), static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses), hitrate);
+
+	if (args.ArgC() >= 2 && std::strcmp(args[1], "reset") == 0)
+	{
+		stats.hits = 0U;
+		stats.misses = 0U;
+		META_CONPRINT("Statistics cleared. \n");
+	}
+}
+
+CON_COMMAND_F(sm_navbot_debug_reachability, "Reports the nav mesh connected components and if the marked area can be reached from your position. Optional: team index.", FCVAR_GAMEDLL | FCVAR_CHEAT)
+{
+	DECLARE_COMMAND_ARGS;
+
+	if (!TheNavMesh->IsLoaded())
+	{
+		META_CONPRINT("Nav mesh not loaded! \n");
+		return;
+	}
+
+	int team = NAV_TEAM_ANY;
+
+	if (args.ArgC() >= 2)
+	{
+		team = atoi(args[1]);
+	}
+
+	CNavReachability& reachability = TheNavMesh->GetReachability();
+
+	META_CONPRINTF("Connected components: %zu (ignoring blocked areas) %zu (team %i) \n", reachability.GetComponentCount(NAV_TEAM_ANY), reachability.GetComponentCount(team), team);
+
+	edict_t* host = UtilHelpers::GetListenServerHost();
+	CNavArea* goal = TheNavMesh->GetMarkedArea();
+
+	if (host == nullptr || goal == nullptr)
+	{
+		return;
+	}
+
+	CNavArea* start = TheNavMesh->GetNearestNavArea(host->GetCollideable()->GetCollisionOrigin(), 512.0f);
+
+	if (start == nullptr)
+	{
+		META_CONPRINT("No Nav Area found near you! \n");
+		return;
+	}
+
+	ShortestPathCost cost;
+	const bool possible = reachability.IsPossiblyReachable(start, goal, team);
+	const bool reachable = NavAreaIsReachableBidirectional(start, goal, cost, 0.0f, team);
+
+	META_CONPRINTF("Area #%u (component %u) to marked area #%u (component %u): %s \n", start->GetID(), reachability.GetComponent(start, team), 
+		goal->GetID(), reachability.GetComponent(goal, team), reachable ? "REACHABLE" : (possible ? "UNREACHABLE (same component)" : "UNREACHABLE (different components)"));
+}
+
+CON_COMMAND_F(sm_navbot_debug_path_cache, "Prints path cache statistics.", FCVAR_GAMEDLL | FCVAR_CHEAT)
+{
+	DECLARE_COMMAND_ARGS;
+
+	if (!TheNavMesh->IsLoaded())
+	{
+		META_CONPRINT("Nav mesh not loaded! \n");
+		return;
+	}
+
+	CNavPathCache& cache = TheNavMesh->GetPathCache();
+	const std::uint64_t lookups = cache.GetHits() + cache.GetMisses();
+	const double hitRate = lookups > 0U ? static_cast<double>(cache.GetHits()) / static_cast<double>(lookups) * 100.0 : 0.0;
+
+	META_CONPRINTF("Path cache: %s, %zu/%zu entries, connectivity epoch %u \n", CNavPathCache::IsEnabled() ? "enabled" : "disabled", 
+		cache.GetEntryCount(), CNavPathCache::MAX_ENTRIES, TheNavMesh->GetConnectivityEpoch());
+	META_CONPRINTF("Hits: %llu Misses: %llu Rejected hits: %llu Hit rate: %3.2f%% \n", static_cast<unsigned long long>(cache.GetHits()), 
+		static_cast<unsigned long long>(cache.GetMisses()), static_cast<unsigned long long>(cache.GetRejected()), hitRate);
+}
+
 CON_COMMAND_F(sm_navbot_debug_disable_bot_combat, "Disables the bot's combat interface.", FCVAR_GAMEDLL | FCVAR_CHEAT)
 {
 	DECLARE_COMMAND_ARGS;
@@ -2110,6 +2262,75 @@ CON_COMMAND_F(sm_navbot_debug_engine_pred, "Predicts entity movement using QPHYS
 		UtilHelpers::textformat::FormatEntity(pEntity), UtilHelpers::textformat::FormatVector(enginepred.GetPredictionData().pos));
 }
 
+CON_COMMAND_F(sm_navbot_debug_bench_projectile_lead, "Benchmarks the iterative and analytic projectile lead solvers.", FCVAR_CHEAT | FCVAR_GAMEDLL)
+{
+	DECLARE_COMMAND_ARGS;
+
+	const int cases = std::clamp(args.FindArgInt("-cases", 100000), 100, 10000000);
+	const int iterations = std::clamp(args.FindArgInt("-iterations", 4), 1, 30);
+	const float speed = std::clamp(static_cast<float>(args.FindArgInt("-speed", 1100)), 100.0f, 10000.0f);
+
+	struct LeadCase
+	{
+		Vector target;
+		Vector velocity;
+	};
+
+	// fixed seed so results can be compared between runs
+	std::mt19937 rng(1234U);
+	std::uniform_real_distribution<float> posdist(-3000.0f, 3000.0f);
+	std::uniform_real_distribution<float> veldist(-450.0f, 450.0f);
+	std::vector<LeadCase> data;
+	std::vector<Vector> results;
+	data.resize(static_cast<std::size_t>(cases));
+	results.resize(static_cast<std::size_t>(cases));
+	const Vector shooter = vec3_origin;
+
+	for (LeadCase& c : data)
+	{
+		c.target.Init(posdist(rng), posdist(rng), posdist(rng) * 0.25f);
+		c.velocity.Init(veldist(rng), veldist(rng), veldist(rng) * 0.5f);
+	}
+
+	// distance between the aim position and the target when a projectile aimed at it arrives
+	auto missdistance = [&shooter, &speed](const LeadCase& c, const Vector& aim) -> float {
+		const float time = (aim - shooter).Length() / speed;
+		return ((c.target + (c.velocity * time)) - aim).Length();
+	};
+
+	auto bench = [&](const char* name, auto solver) {
+		auto tstart = std::chrono::high_resolution_clock::now();
+
+		for (std::size_t i = 0; i < data.size(); i++)
+		{
+			results[i] = solver(data[i]);
+		}
+
+		auto tend = std::chrono::high_resolution_clock::now();
+		const std::chrono::duration<double, std::nano> nanos = (tend - tstart);
+		double totalerror = 0.0;
+		float maxerror = 0.0f;
+
+		for (std::size_t i = 0; i < data.size(); i++)
+		{
+			const float error = missdistance(data[i], results[i]);
+			totalerror += static_cast<double>(error);
+			maxerror = std::max(maxerror, error);
+		}
+
+		META_CONPRINTF("  %-24s %8.2f ns/solve  avg miss %8.3f  max miss %10.3f \n", name, nanos.count() / static_cast<double>(cases),
+			totalerror / static_cast<double>(cases), maxerror);
+	};
+
+	META_CONPRINTF("Projectile lead benchmark: %i cases, projectile speed %3.1f \n", cases, speed);
+
+	bench("Iterative (1)", [&shooter, &speed](const LeadCase& c) { return pred::IterativeProjectileLead(shooter, c.target, c.velocity, speed, 1); });
+	char name[32];
+	ke::SafeSprintf(name, sizeof(name), "Iterative (%i)", iterations);
+	bench(name, [&shooter, &speed, &iterations](const LeadCase& c) { return pred::IterativeProjectileLead(shooter, c.target, c.velocity, speed, iterations); });
+	bench("Analytic", [&shooter, &speed](const LeadCase& c) { return pred::AnalyticProjectileLead(shooter, c.target, c.velocity, speed); });
+}
+
 CON_COMMAND_F(sm_navbot_debug_bot_highlight_reachable_areas, "Highlights areas currently reachable to the given bot.", FCVAR_GAMEDLL | FCVAR_CHEAT)
 {
 	DECLARE_COMMAND_ARGS;
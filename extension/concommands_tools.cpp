@@ -298,6 +298,123 @@ CON_COMMAND_F(sm_navbot_tool_build_path, "Builds a path from your current positi
 	}
 }
 
+// NavAreaBuildPath functor with the same travel cost as NavAStarPathCost, so both searches can be compared
+class CToolsBenchmarkBuildPathCost
+{
+public:
+	float operator()(CNavArea* area, CNavArea* fromArea, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator, float length) const
+	{
+		if (fromArea == nullptr)
+		{
+			return 0.0f;
+		}
+
+		return fromArea->GetCostSoFar() + m_cost(area, fromArea, ladder, link, elevator);
+	}
+
+private:
+	NavAStarPathCost m_cost;
+};
+
+CON_COMMAND_F(sm_navbot_tool_benchmark_pathfinding, "Runs INavAStarSearch and NavAreaBuildPath on the same random area pairs and compares them.", FCVAR_CHEAT)
+{
+	DECLARE_COMMAND_ARGS;
+
+	if (!TheNavMesh->IsLoaded() || TheNavAreas.Count() < 2)
+	{
+		META_CONPRINT("A nav mesh with at least 2 areas is needed! \n");
+		return;
+	}
+
+	int count = 500;
+	unsigned int seed = 0U;
+
+	if (args.ArgC() >= 2)
+	{
+		count = std::clamp(atoi(args[1]), 1, 100000);
+	}
+
+	if (args.ArgC() >= 3)
+	{
+		seed = static_cast<unsigned int>(atoi(args[2]));
+	}
+
+	librandom::RandomNumberGenerator<std::mt19937, unsigned int> rng;
+	rng.ReSeed(seed);
+
+	std::vector<std::pair<CNavArea*, CNavArea*>> pairs;
+	pairs.reserve(static_cast<std::size_t>(count));
+
+	for (int i = 0; i < count; i++)
+	{
+		CNavArea* start = TheNavAreas[rng.GetRandomInt<int>(0, TheNavAreas.Count() - 1)];
+		CNavArea* goal = TheNavAreas[rng.GetRandomInt<int>(0, TheNavAreas.Count() - 1)];
+		pairs.emplace_back(start, goal);
+	}
+
+	NavAStarPathCost astarCost;
+	NavAStarHeuristicCost astarHeuristic;
+	INavAStarSearch<CNavArea> search;
+	std::vector<float> astarCosts;
+	astarCosts.reserve(pairs.size());
+	int astarFound = 0;
+
+	auto tstart = std::chrono::high_resolution_clock::now();
+
+	for (auto& pair : pairs)
+	{
+		search.SetStart(pair.first);
+		search.SetGoalArea(pair.second);
+		search.DoSearch(astarCost, astarHeuristic);
+
+		if (search.FoundPath())
+		{
+			astarFound++;
+			astarCosts.push_back(search.GetTotalCost());
+		}
+		else
+		{
+			astarCosts.push_back(-1.0f);
+		}
+	}
+
+	auto tend = std::chrono::high_resolution_clock::now();
+	const std::chrono::duration<double, std::milli> astarMillis = (tend - tstart);
+
+	CToolsBenchmarkBuildPathCost buildPathCost;
+	int buildPathFound = 0;
+	int mismatches = 0;
+	std::size_t index = 0;
+
+	tstart = std::chrono::high_resolution_clock::now();
+
+	for (auto& pair : pairs)
+	{
+		const bool found = NavAreaBuildPath(pair.first, pair.second, nullptr, buildPathCost);
+		const float cost = found ? pair.second->GetCostSoFar() : -1.0f;
+
+		if (found)
+		{
+			buildPathFound++;
+		}
+
+		if (found != (astarCosts[index] >= 0.0f) || std::fabs(cost - astarCosts[index]) > 1.0f)
+		{
+			mismatches++;
+		}
+
+		index++;
+	}
+
+	tend = std::chrono::high_resolution_clock::now();
+	const std::chrono::duration<double, std::milli> buildPathMillis = (tend - tstart);
+
+	META_CONPRINTF("Pathfinding benchmark: %i searches on %i areas (seed %u) \n", count, TheNavAreas.Count(), seed);
+	META_CONPRINTF("  INavAStarSearch: %g ms total, %g ms avg, %i paths found \n", astarMillis.count(), astarMillis.count() / static_cast<double>(count), astarFound);
+	META_CONPRINTF("  NavAreaBuildPath: %g ms total, %g ms avg, %i paths found \n", buildPathMillis.count(), buildPathMillis.count() / static_cast<double>(count), buildPathFound);
+	META_CONPRINTF("  Results with a different outcome or cost: %i \n", mismatches);
+}
+
 CON_COMMAND_F(sm_navbot_tool_report_player_info, "Prints some information about the player entity.", FCVAR_CHEAT)
 {
 	edict_t* host = UtilHelpers::GetListenServerHost();
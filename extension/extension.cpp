@@ -40,6 +40,7 @@
 #include <util/helpers.h>
 #include <util/librandom.h>
 #include <util/sdkcalls.h>
+#include <util/hotpath_profiler.h>
 #include <mods/basemod.h>
 #include <bot/basebot.h>
 #include <sdkports/sdk_takedamageinfo.h>
@@ -640,6 +641,8 @@ void NavBotExt::Hook_GameFrame(bool simulating)
 
 #endif // EXT_DEBUG
 
+	hotprof::OnFrameEnd();
+
 	RETURN_META(MRES_IGNORED);
 }
 
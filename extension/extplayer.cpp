@@ -21,6 +21,8 @@
 constexpr auto PLAYER_NAV_UPDATE_TIME = 0.1f; // Interval of nav mesh data updates
 constexpr auto NEAREST_AREA_MAX_DISTANCE = 128.0f;
 
+CBaseExtPlayer::NavAreaLookupStats CBaseExtPlayer::s_navarealookupstats{ 0U, 0U };
+
 CBaseExtPlayer::CBaseExtPlayer(edict_t* edict)
 {
 	m_edict = edict;
@@ -123,13 +125,25 @@ void CBaseExtPlayer::UpdateLastKnownNavArea(const bool forceupdate)
 		return; // don't update if the bot is midair
 	}
 
-	float maxDist = waterlevel == static_cast<int>(entityprops::WaterLevel::WL_NotInWater) ? 50.0f : 512.0f;
-
-	CNavArea* newarea = TheNavMesh->GetNearestNavArea(GetEdict(), GETNAVAREA_CHECK_GROUND | GETNAVAREA_CHECK_LOS, maxDist);
+	// players usually stay in the same area or move to a connected one, check these before searching the nav mesh
+	CNavArea* newarea = FindNavAreaNearLastKnown(GetAbsOrigin());
 
-	if (!newarea)
+	if (newarea)
 	{
-		return;
+		s_navarealookupstats.hits++;
+	}
+	else
+	{
+		s_navarealookupstats.misses++;
+
+		float maxDist = waterlevel == static_cast<int>(entityprops::WaterLevel::WL_NotInWater) ? 50.0f : 512.0f;
+
+		newarea = TheNavMesh->GetNearestNavArea(GetEdict(), GETNAVAREA_CHECK_GROUND | GETNAVAREA_CHECK_LOS, maxDist);
+
+		if (!newarea)
+		{
+			return;
+		}
 	}
 
 	if (newarea != m_lastnavarea)
@@ -141,6 +155,45 @@ void CBaseExtPlayer::UpdateLastKnownNavArea(const bool forceupdate)
 	m_navupdatetimer = TIME_TO_TICKS(PLAYER_NAV_UPDATE_TIME);
 }
 
+CNavArea* CBaseExtPlayer::FindNavAreaNearLastKnown(const Vector& origin) const
+{
+	if (m_lastnavarea == nullptr)
+	{
+		return nullptr;
+	}
+
+	const int team = GetCurrentTeamIndex();
+
+	// same test as CNavMesh::GetNavArea does for players
+	auto contains = [&origin, &team](CNavArea* area) -> bool {
+		if (!area->IsOverlapping(origin) || area->IsBlocked(team))
+		{
+			return false;
+		}
+
+		const float z = area->GetZ(origin);
+		return z <= origin.z + navgenparams->step_height && z >= origin.z - navgenparams->step_height;
+	};
+
+	if (contains(m_lastnavarea))
+	{
+		return m_lastnavarea;
+	}
+
+	CNavArea* result = nullptr;
+
+	auto functor = [&result, &contains](CNavArea* area, bool isIncomingArea) {
+		if (result == nullptr && contains(area))
+		{
+			result = area;
+		}
+	};
+
+	m_lastnavarea->ForEachAdjacentAndIncomingArea(functor);
+
+	return result;
+}
+
 const Vector CBaseExtPlayer::WorldSpaceCenter() const
 {
 	return UtilHelpers::getWorldSpaceCenter(GetEdict());
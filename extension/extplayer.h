@@ -51,6 +51,15 @@ public:
 	inline CNavArea* GetLastKnownNavArea() const { return m_lastnavarea; }
 	void SetLastKnownNavArea(CNavArea* area) { if (area) { m_lastnavarea = area; } }
 	void UpdateLastKnownNavArea(const bool forceupdate = false);
+
+	// Last known nav area lookup statistics, shared by all players
+	struct NavAreaLookupStats
+	{
+		std::uint64_t hits; // lookups resolved by the last known area or one of its neighbors
+		std::uint64_t misses; // lookups that needed a nav mesh grid search
+	};
+
+	static NavAreaLookupStats s_navarealookupstats;
 	inline void ClearLastKnownNavArea() { m_lastnavarea = nullptr; }
 	inline IPlayerInfo* GetPlayerInfo() { return m_playerinfo; }
 	const Vector WorldSpaceCenter() const;
@@ -199,6 +208,8 @@ private:
 	int m_prethinkHook;
 
 	void SetupPlayerHooks();
+	// Searches the last known nav area and the areas connected to it for an area containing the given position
+	CNavArea* FindNavAreaNearLastKnown(const Vector& origin) const;
 	/* CBasePlayer::PreThink hook */
 	void Hook_PreThink();
 };
@@ -4,6 +4,10 @@
 #include "manager.h"
 #include "mod_loader.h"
 #include <bot/interfaces/weapons/dynamic_priority_manager.h>
+#include <bot/interfaces/task_memory_pool.h>
+#include <util/memory_tracker.h>
+#include <util/hotpath_profiler.h>
+#include <util/prediction.h>
 #include <navmesh/nav_mesh.h>
 
 #ifdef EXT_DEBUG
@@ -151,6 +155,8 @@ void CExtManager::Frame()
 	VPROF_BUDGET("CExtManager::Frame", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CExtManager::Frame");
+
 	/*
 	* This is now called by the CBasePlayer::PhysicsSimulate() hook
 	for (auto& botptr : m_bots)
@@ -162,6 +168,9 @@ void CExtManager::Frame()
 
 	m_mod->Frame();
 
+	// all bots have thought for this tick, prepare data for the next tick
+	m_thinkPipeline.Run();
+
 	if (m_callModUpdateTimer.IsElapsed())
 	{
 		m_callModUpdateTimer.Start(MOD_UPDATE_INTERVAL);
@@ -241,6 +250,10 @@ void CExtManager::OnClientDisconnect(int client)
 		return false;
 	}), m_bots.end());
 
+	memtracker::ResetOwner(static_cast<std::uint32_t>(client));
+	hotprof::ResetBot(client);
+	m_updateScheduler.OnBotRemoved(client);
+
 	m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [&client](const std::unique_ptr<CBaseExtPlayer>& object) {
 		if (object->GetIndex() == client)
 		{
@@ -255,6 +268,8 @@ void CExtManager::OnMapStart()
 {
 	TheNavMesh->OnMapStart();
 	m_mod->OnMapStart();
+	m_updateScheduler.Reset();
+	m_thinkPipeline.Reset();
 
 	if (m_botnames.size() != 0)
 	{
@@ -284,6 +299,8 @@ void CExtManager::OnMapEnd()
 {
 	TheNavMesh->OnMapEnd();
 	m_mod->OnMapEnd();
+	CTaskMemoryPool::ReleaseAllUnused();
+	pred::CTrajectoryCache::GetInstance().Clear();
 }
 
 // Detect current mod and initializes it
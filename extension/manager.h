@@ -6,6 +6,8 @@
 #include <bot/bot_debug_shared.h>
 #include <bot/interfaces/profile.h>
 #include <bot/basebot.h>
+#include <bot/bot_update_scheduler.h>
+#include <bot/bot_think_pipeline.h>
 #include <mods/gamemods_shared.h>
 #include <sdkports/sdk_timers.h>
 #include <IForwardSys.h>
@@ -134,6 +136,31 @@ public:
 			functor(bot);
 		}
 	}
+	/**
+	 * @brief Runs a function on each bot that can hear a sound emitted at the given position.
+	 * @tparam T A class with operator() overload with one parameter void (CBaseBot* bot).
+	 * @param origin Sound origin.
+	 * @param maxRadius Maximum distance between the bot's ears and the sound origin.
+	 * @param functor Function to call on each bot.
+	 */
+	template <typename T>
+	inline void ForEachBotInHearingRange(const Vector& origin, const float maxRadius, T& functor)
+	{
+		const float maxRadiusSqr = maxRadius * maxRadius;
+
+		for (auto& ptr : m_bots)
+		{
+			CBaseBot* bot = ptr.get();
+
+			// same test done by the sensor interface, skips the whole event listener tree for bots that can't hear it
+			if ((bot->GetEarOrigin() - origin).LengthSqr() > maxRadiusSqr)
+			{
+				continue;
+			}
+
+			functor(bot);
+		}
+	}
 	/**
 	 * @brief Runs a function on each player instance.
 	 * @tparam T A class with operator() overload with one parameter void (CBaseExtPlayer* player).
@@ -190,6 +217,8 @@ public:
 	static int AutoComplete_BotNames(const char* partial, char commands[COMMAND_COMPLETION_MAXITEMS][COMMAND_COMPLETION_ITEM_LENGTH]);
 
 	CServerCommandManager& GetServerCommandManager() { return m_serverCommandManager; }
+	CBotUpdateScheduler& GetBotUpdateScheduler() { return m_updateScheduler; }
+	const CBotThinkPipeline& GetBotThinkPipeline() const { return m_thinkPipeline; }
 
 	// If true, the current game/mod has support for loading maps from steam workshop.
 	static bool ModUsesWorkshopMaps() { return s_usesworkshop; }
@@ -256,6 +285,8 @@ private:
 	bool m_allowbots; // allow bots to be created
 	CountdownTimer m_callModUpdateTimer; // timer for calling the mod update function
 	CServerCommandManager m_serverCommandManager;
+	CBotUpdateScheduler m_updateScheduler; // decides which bots runs a full AI update each tick
+	CBotThinkPipeline m_thinkPipeline; // per bot data prepared for the next tick
 
 	// Getting horrible performance at vstdlib.dll from a function called by ConVarRef::Init, so we are caching the sv_gravity value here
 	static inline float s_sv_gravity{ 800.0f };
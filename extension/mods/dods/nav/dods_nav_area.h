@@ -23,6 +23,7 @@ public:
 	};
 
 	void OnUpdate() override;
+	bool WantsUpdate() const override { return HasBombRelatedAttributes(); }
 	void OnRoundRestart(void) override;
 	void Save(std::fstream& filestream, uint32_t version) override;
 	NavErrorType Load(std::fstream& filestream, uint32_t version, uint32_t subVersion) override;
@@ -107,7 +107,7 @@ void CDoDSNavMesh::OnRCBot2WaypointImported(const CRCBot2Waypoint& waypoint, con
 
 std::shared_ptr<CWaypoint> CDoDSNavMesh::CreateWaypoint() const
 {
-	return std::make_shared<CDoDSWaypoint>();
+	return std::allocate_shared<CDoDSWaypoint>(memtracker::TrackedAllocator<CDoDSWaypoint, memtracker::Category::WAYPOINTS>());
 }
 
 void CDoDSNavMesh::ComputeInternalData()
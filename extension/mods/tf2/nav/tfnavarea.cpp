@@ -2,6 +2,7 @@
 #include <utlbuffer.h>
 #include <filesystem.h>
 #include <mods/modhelpers.h>
+#include <sdkports/sdk_traces.h>
 #include "tfnavmesh.h"
 #include "tfnavarea.h"
 
@@ -16,6 +17,7 @@ void CTFNavArea::Save(std::fstream& filestream, uint32_t version)
 	filestream.write(reinterpret_cast<char*>(&m_tfattributes), sizeof(int));
 	filestream.write(reinterpret_cast<char*>(&m_tfpathattributes), sizeof(int));
 	filestream.write(reinterpret_cast<char*>(&m_mvmattributes), sizeof(int));
+	filestream.write(reinterpret_cast<char*>(&m_buildableFootprint), sizeof(bool));
 }
 
 NavErrorType CTFNavArea::Load(std::fstream& filestream, uint32_t version, uint32_t subVersion)
@@ -39,9 +41,40 @@ NavErrorType CTFNavArea::Load(std::fstream& filestream, uint32_t version, uint32
 		}
 	}
 
+	if (subVersion >= 2)
+	{
+		filestream.read(reinterpret_cast<char*>(&m_buildableFootprint), sizeof(bool));
+
+		if (!filestream.good())
+		{
+			return NAV_CORRUPT_DATA;
+		}
+	}
+	else
+	{
+		InvalidateStaticAttributes(); // compute the footprint on first access
+	}
+
 	return NAV_OK;
 }
 
+void CTFNavArea::ComputeStaticAttributes()
+{
+	CNavArea::ComputeStaticAttributes();
+
+	// sentry gun hull size
+	static const Vector mins(-20.0f, -20.0f, 0.0f);
+	static const Vector maxs(20.0f, 20.0f, 66.0f);
+
+	Vector start = GetCenter();
+	start.z += navgenparams->step_height;
+	CTraceFilterWorldAndPropsOnly filter;
+	trace_t tr;
+	trace::hull(start, start, mins, maxs, MASK_PLAYERSOLID, &filter, tr);
+
+	m_buildableFootprint = !tr.startsolid && !tr.allsolid;
+}
+
 void CTFNavArea::ImportLoadGameSpecific(CUtlBuffer& filebuffer, unsigned int version, unsigned int subVersion)
 {
 	if (CTFNavMesh::s_isTF2C)
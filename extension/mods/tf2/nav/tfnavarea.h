@@ -15,11 +15,13 @@ public:
 		m_mvmattributes = 0;
 		m_spawnroomteam = 0;
 		m_rtattributes = 0;
+		m_buildableFootprint = false;
 	}
 
 	void Save(std::fstream& filestream, uint32_t version) override;
 	NavErrorType Load(std::fstream& filestream, uint32_t version, uint32_t subVersion) override;
 	void ImportLoadGameSpecific(CUtlBuffer& filebuffer, unsigned int version, unsigned int subVersion) override;
+	void ComputeStaticAttributes() override;
 	void UpdateBlocked(bool force = false, int teamID = NAV_TEAM_ANY) override;
 	bool IsBlocked(int teamID, bool ignoreNavBlockers = false) const override;
 	inline TeamFortress2::TFTeam GetSpawnRoomTeam() const { return static_cast<TeamFortress2::TFTeam>(m_spawnroomteam); }
@@ -190,7 +192,15 @@ public:
 		return true;
 	}
 
+	// Returns true if an engineer building fits at the area center
+	bool HasBuildableFootprint()
+	{
+		GetStaticAttributes(); // computes the footprint if needed
+		return m_buildableFootprint;
+	}
+
 private:
+	bool m_buildableFootprint; // static attribute: a sentry gun fits at the center of this area
 	int m_tfpathattributes;
 	int m_tfattributes;
 	int m_mvmattributes; // Attributes exclusive for the Mann vs Machine game modes
@@ -436,7 +436,7 @@ void CTFNavMesh::PostCustomAnalysis(void)
 
 std::shared_ptr<CWaypoint> CTFNavMesh::CreateWaypoint() const
 {
-	return std::make_shared<CTFWaypoint>();
+	return std::allocate_shared<CTFWaypoint>(memtracker::TrackedAllocator<CTFWaypoint, memtracker::Category::WAYPOINTS>());
 }
 
 CDoorNavBlocker* CTFNavMesh::CreateDoorBlocker() const
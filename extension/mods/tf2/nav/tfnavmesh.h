@@ -61,9 +61,10 @@ inline uint32_t CTFNavMesh::GetSubVersionNumber(void) const
 	/*
 	* Sub version 
 	* 1: Initial TF Nav Mesh implementation
+	* 2: Static buildable footprint
 	*/
 
-	return 1;
+	return 2;
 }
 
 inline CTFNavMesh* TheTFNavMesh()
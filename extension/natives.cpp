@@ -179,7 +179,7 @@ namespace natives
 			}
 		};
 
-		extmanager->ForEachBot(functor);
+		extmanager->ForEachBotInHearingRange(origin, maxRadius, functor);
 
 		return 0;
 	}
@@ -79,7 +79,6 @@ constexpr float DEF_NAV_VIEW_DISTANCE = 1500.0;
 // ConVar sm_nav_update_visibility_on_edit( "sm_nav_update_visibility_on_edit", "0", FCVAR_CHEAT, "If nonzero editing the mesh will incrementally recompue visibility" );
 // ConVar sm_nav_potentially_visible_dot_tolerance( "sm_nav_potentially_visible_dot_tolerance", "0.98", FCVAR_CHEAT );
 // ConVar sm_nav_show_potentially_visible( "sm_nav_show_potentially_visible", "0", FCVAR_CHEAT, "Show areas that are potentially visible from the current nav area" );
-static ConVar sm_nav_danger_decay_rate("sm_nav_danger_decay_rate", "20", FCVAR_GAMEDLL, "How much area danger is decayed per second.", true, 1.0f, true, 100.0f);
 
 Color s_selectedSetColor( 255, 255, 200, 96 );
 Color s_selectedSetBorderColor( 100, 100, 0, 255 );
@@ -217,6 +216,7 @@ CNavArea::CNavArea(unsigned int place)
 	m_attributeFlags = 0;
 	m_place = place;
 	m_isUnderwater = false;
+	m_staticAttributes = NavAreaStaticAttributes{};
 	m_avoidanceObstacleHeight = 0.0f;
 
 	m_totalCost = 0.0f;
@@ -236,8 +236,6 @@ CNavArea::CNavArea(unsigned int place)
 		m_earliestOccupyTime[i] = 0.0f;
 	}
 
-	std::fill(m_danger.begin(), m_danger.end(), 0.0f);
-
 	// set an ID for splitting and other interactive editing - loads will overwrite this
 	m_id = m_nextID++;
 	m_debugid = 0;
@@ -555,7 +553,6 @@ void CNavArea::OnServerActivate( void )
 {
 	m_damagingTickCount = 0;
 	ClearAllNavCostEntities();
-	ClearDanger(NAV_TEAM_ANY);
 }
 
 //--------------------------------------------------------------------------------------------------------------
@@ -566,7 +563,6 @@ void CNavArea::OnRoundRestart( void )
 {
 	m_damagingTickCount = 0;
 	ClearAllNavCostEntities();
-	ClearDanger(NAV_TEAM_ANY);
 	ResetClearedTimestamp(NAV_TEAM_ANY);
 }
 
@@ -635,11 +631,6 @@ bool CNavArea::HasNodes( void ) const
 	return false;
 }
 
-void CNavArea::OnUpdate()
-{
-	DecayDanger();
-}
-
 //--------------------------------------------------------------------------------------------------------------
 /**
  * This is invoked when an area is going away.
@@ -647,6 +638,7 @@ void CNavArea::OnUpdate()
  */
 void CNavArea::OnDestroyNotify( CNavArea *dead )
 {
+	TheNavMesh->OnAreaConnectionsChanged();
 	NavConnect con;
 	con.area = dead;
 	for( int d=0; d<NUM_DIRECTIONS; ++d )
@@ -693,6 +685,7 @@ void CNavArea::ConnectTo( CNavArea *area, NavDirType dir )
 	con.length = ( area->GetCenter() - GetCenter() ).Length();
 	m_connect[ dir ].AddToTail( con );
 	m_incomingConnect[ dir ].FindAndRemove( con );
+	TheNavMesh->OnAreaConnectionsChanged();
 
 	NavDirType dirOpposite = OppositeDirection( dir );
 	con.area = this;
@@ -751,6 +744,7 @@ bool CNavArea::ConnectTo(CNavArea* area, OffMeshConnectionType linktype, const V
 	pos.z = start.z;
 
 	m_offmeshconnections.emplace_back(linktype, area, pos, end);
+	TheNavMesh->OnAreaConnectionsChanged();
 	Msg("Added off-mesh connection between area #%i and #%i \n", GetID(), area->GetID());
 	NDebugOverlay::HorzArrow(pos + Vector(0.0f, 0.0f, 72.0f), pos, 4.0f, 0, 255, 255, 255, true, 10.0f);
 
@@ -763,6 +757,7 @@ bool CNavArea::ConnectTo(CNavArea* area, OffMeshConnectionType linktype, const V
  */
 void CNavArea::Disconnect( CNavArea *area )
 {
+	TheNavMesh->OnAreaConnectionsChanged();
 	NavConnect connect;
 	connect.area = area;
 
@@ -794,6 +789,7 @@ void CNavArea::Disconnect( CNavArea *area )
  */
 void CNavArea::Disconnect( CNavLadder *ladder )
 {
+	TheNavMesh->OnAreaConnectionsChanged();
 	NavLadderConnect con;
 	con.ladder = ladder;
 
@@ -805,6 +801,7 @@ void CNavArea::Disconnect( CNavLadder *ladder )
 
 void CNavArea::Disconnect(CNavArea* area, OffMeshConnectionType linktype)
 {
+	TheNavMesh->OnAreaConnectionsChanged();
 	m_offmeshconnections.erase(std::remove_if(m_offmeshconnections.begin(), m_offmeshconnections.end(), [&area, &linktype](const NavOffMeshConnection& connection) {
 		return connection.GetConnectedArea() == area && connection.m_type == linktype;
 	}), m_offmeshconnections.end());
@@ -3860,6 +3857,8 @@ void CNavArea::ClearSearchLists( void )
 //--------------------------------------------------------------------------------------------------------------
 void CNavArea::SetCorner( NavCornerType corner, const Vector& newPosition )
 {
+	InvalidateStaticAttributes();
+
 	switch( corner )
 	{
 		case NORTH_WEST:
@@ -3911,19 +3910,19 @@ void CNavArea::SetCorner( NavCornerType corner, const Vector& newPosition )
 }
 
 
-void CNavArea::DecayDanger()
+float CNavArea::GetDanger(int teamID) const
 {
-	const float decay = sm_nav_danger_decay_rate.GetFloat();
+	return TheNavMesh->GetDangerMap().GetDanger(GetID(), teamID);
+}
 
-	for (size_t i = 0; i < NAV_TEAMS_ARRAY_SIZE; i++)
-	{
-		m_danger[i] = m_danger[i] - decay;
+void CNavArea::IncreaseDanger(int teamID, const float amount)
+{
+	TheNavMesh->GetDangerMap().IncreaseDanger(GetID(), teamID, amount);
+}
 
-		if (m_danger[i] < 0.0f)
-		{
-			m_danger[i] = 0.0f;
-		}
-	}
+void CNavArea::ClearDanger(int teamID)
+{
+	TheNavMesh->GetDangerMap().ClearDanger(GetID(), teamID);
 }
 
 //--------------------------------------------------------------------------------------------------------------
@@ -4413,6 +4412,8 @@ CON_COMMAND_F( sm_nav_update_lighting, "Recomputes lighting values", FCVAR_CHEAT
  */
 void CNavArea::RaiseCorner( NavCornerType corner, int amount, bool raiseAdjacentCorners )
 {
+	InvalidateStaticAttributes();
+
 	if ( corner == NUM_CORNERS )
 	{
 		RaiseCorner( NORTH_WEST, amount, raiseAdjacentCorners );
@@ -4660,6 +4661,7 @@ void CNavArea::Shift( const Vector &shift )
 	m_seCorner += shift;
 	
 	m_center += shift;
+	InvalidateStaticAttributes();
 }
 
 
@@ -5267,6 +5269,26 @@ void CNavArea::CheckWaterLevel(void)
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+/**
+ * Compute the static geometry attributes of this area
+ */
+void CNavArea::ComputeStaticAttributes(void)
+{
+	m_staticAttributes = NavAreaStaticAttributes{};
+	m_staticAttributes.isValid = true;
+
+	Vector start = GetCenter();
+	start.z += navgenparams->step_height;
+	Vector normal;
+
+	if (trace::getgroundnormal(start, normal))
+	{
+		m_staticAttributes.groundNormal = normal;
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 static void CommandNavCheckFloor( void )
 {
@@ -25,6 +25,7 @@
 #include "nav_ladder.h"
 #include "nav_elevator.h"
 #include <sdkports/sdk_timers.h>
+#include <util/memory_tracker.h>
 #include <networkvar.h>
 
 // BOTPORT: Clean up relationship between team index and danger storage in nav areas
@@ -118,7 +119,7 @@ union NavLadderConnect
 /**
  * A HidingSpot is a good place for a bot to crouch and wait for enemies
  */
-class HidingSpot
+class HidingSpot : public memtracker::CTrackedObject<memtracker::Category::HIDING_SPOTS>
 {
 public:
 	virtual ~HidingSpot()	{ }
@@ -322,7 +323,27 @@ protected:
 	// --- End critical data --- 
 };
 
-class CNavArea : protected CNavAreaCriticalData
+/**
+ * @brief Static geometry attributes of a nav area.
+ * 
+ * Computed during analysis and saved in the nav mesh file so bots don't need to trace for them at runtime.
+ */
+struct NavAreaStaticAttributes
+{
+	NavAreaStaticAttributes() :
+		groundNormal(0.0f, 0.0f, 1.0f)
+	{
+		isValid = false;
+	}
+
+	Vector groundNormal; // ground surface normal at the area center
+	bool isValid; // false if the attributes still needs to be computed
+
+	// Returns the ground flatness, 1 is flat ground
+	float GetFlatness() const { return groundNormal.z; }
+};
+
+class CNavArea : protected CNavAreaCriticalData, public memtracker::CTrackedObject<memtracker::Category::NAV_AREAS>
 {
 public:
 	DECLARE_CLASS_NOBASE( CNavArea )
@@ -336,7 +357,8 @@ public:
 	virtual void OnEnter( edict_t *who, CNavArea *areaJustLeft ) { }	// invoked when player enters this area
 	virtual void OnExit( edict_t *who, CNavArea *areaJustEntered ) { }	// invoked when player exits this area
 	virtual void OnFrame() {}				// invoked every server frame
-	virtual void OnUpdate();				// invoked at intervals
+	virtual void OnUpdate() {}				// invoked at intervals
+	virtual bool WantsUpdate() const { return false; }	// return true to be in the nav mesh active area list, only areas in the list get OnFrame and OnUpdate calls
 
 	virtual void OnDestroyNotify( CNavArea *dead );				// invoked when given area is going away
 	virtual void OnDestroyNotify( CNavLadder *dead );			// invoked when given ladder is going away
@@ -444,6 +466,22 @@ public:
 	void CheckWaterLevel( void );
 	bool IsUnderwater( void ) const		{ return m_isUnderwater; }
 
+	/**
+	 * @brief Gets the area static geometry attributes. Areas without them (IE: loaded from older nav mesh files) computes them on first access.
+	 * @return Static attributes.
+	 */
+	const NavAreaStaticAttributes& GetStaticAttributes()
+	{
+		if (!m_staticAttributes.isValid)
+		{
+			ComputeStaticAttributes();
+		}
+
+		return m_staticAttributes;
+	}
+	virtual void ComputeStaticAttributes( void );				// (EXTEND) computes the static geometry attributes
+	void InvalidateStaticAttributes( void ) { m_staticAttributes.isValid = false; }
+
 	bool IsOverlapping( const Vector &pos, float tolerance = 0.0f ) const;	// return true if 'pos' is within 2D extents of area.
 	bool IsOverlapping( const CNavArea *area ) const;			// return true if 'area' overlaps our 2D extents
 	bool IsOverlapping( const Extent &extent ) const;			// return true if 'extent' overlaps our 2D extents
@@ -598,21 +636,11 @@ public:
 	/* Danger */
 
 	/**
-	 * @brief Gets the current danger value of this area.
+	 * @brief Gets the current danger value of this area. Danger is stored in the nav mesh danger map.
 	 * @param teamID Team ID to get the danger from (required)
 	 * @return Danger value.
 	 */
-	inline const float GetDanger(int teamID) const
-	{
-		if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
-		{
-			return 0.0f;
-		}
-		else
-		{
-			return m_danger[teamID];
-		}
-	}
+	float GetDanger(int teamID) const;
 
 	/* Common danger amounts */
 	static constexpr float ADD_DANGER_KILLED = 600.0f; // Bot was killed
@@ -628,36 +656,13 @@ public:
 	 * @param max Increase danger up to this to avoid excessive danger values.
 	 * @param amount Amount to increase.
 	 */
-	inline void IncreaseDanger(int teamID, const float amount)
-	{
-		if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
-		{
-			for (size_t i = 0; i < NAV_TEAMS_ARRAY_SIZE; i++)
-			{
-				m_danger[i] += amount;
-			}
-		}
-		else
-		{
-			m_danger[teamID] += amount;
-		}
-	}
+	void IncreaseDanger(int teamID, const float amount);
 	
 	/**
 	 * @brief Clears the danger (sets to 0).
 	 * @param teamID Team to clear the danger for. NAV_TEAM_ANY for all teams.
 	 */
-	inline void ClearDanger(int teamID)
-	{
-		if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
-		{
-			std::fill(m_danger.begin(), m_danger.end(), 0.0f);
-		}
-		else
-		{
-			m_danger[teamID] = 0.0f;
-		}
-	}
+	void ClearDanger(int teamID);
 
 	//- extents -----------------------------------------------------------------------------------------
 	float GetSizeX( void ) const			{ return m_seCorner.x - m_nwCorner.x; }
@@ -801,7 +806,7 @@ public:
 
 				if (ladder != nullptr)
 				{
-					if (ladder->IsConnected(this))
+					if (ladder->IsConnected(other))
 					{
 						return ladder;
 					}
@@ -959,6 +964,73 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Runs a function on each connection of this area, passing how the connected area is reached.
+	 *
+	 * Same areas as ForEachConnectedArea but the connection type is given inline, no need to look it up with GetXConnectionToArea.
+	 * @tparam T A class with operator() overload or a lambda expression with 4 parameters
+	 * void (CNavArea* connectedArea, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator)
+	 * At most one of ladder, link and elevator is not NULL. All of them are NULL for adjacent areas.
+	 * @param functor function to run on each connection of this area
+	 */
+	template <typename T>
+	inline void ForEachConnection(T& functor)
+	{
+		for (int dir = 0; dir < static_cast<int>(NUM_DIRECTIONS); dir++)
+		{
+			const NavConnectVector& conn = m_connect[dir];
+
+			for (int i = 0; i < conn.Count(); i++)
+			{
+				functor(conn[i].area, static_cast<const CNavLadder*>(nullptr), static_cast<const NavOffMeshConnection*>(nullptr), static_cast<const CNavElevator*>(nullptr));
+			}
+		}
+
+		for (int i = 0; i < m_ladder[CNavLadder::LADDER_UP].Count(); i++)
+		{
+			const CNavLadder* ladder = m_ladder[CNavLadder::LADDER_UP][i].ladder;
+
+			for (auto& lc : ladder->GetConnections())
+			{
+				if (lc.IsConnectedToLadderTop())
+				{
+					functor(lc.GetConnectedArea(), ladder, static_cast<const NavOffMeshConnection*>(nullptr), static_cast<const CNavElevator*>(nullptr));
+				}
+			}
+		}
+
+		for (int i = 0; i < m_ladder[CNavLadder::LADDER_DOWN].Count(); i++)
+		{
+			const CNavLadder* ladder = m_ladder[CNavLadder::LADDER_DOWN][i].ladder;
+
+			for (auto& lc : ladder->GetConnections())
+			{
+				if (lc.IsConnectedToLadderBottom())
+				{
+					functor(lc.GetConnectedArea(), ladder, static_cast<const NavOffMeshConnection*>(nullptr), static_cast<const CNavElevator*>(nullptr));
+				}
+			}
+		}
+
+		for (auto& link : m_offmeshconnections)
+		{
+			functor(link.m_link.area, static_cast<const CNavLadder*>(nullptr), &link, static_cast<const CNavElevator*>(nullptr));
+		}
+
+		if (m_elevator != nullptr)
+		{
+			for (auto& floor : m_elevator->GetFloors())
+			{
+				CNavArea* connectedArea = floor.GetArea();
+
+				if (connectedArea != this)
+				{
+					functor(connectedArea, static_cast<const CNavLadder*>(nullptr), static_cast<const NavOffMeshConnection*>(nullptr), m_elevator);
+				}
+			}
+		}
+	}
+
 protected:
 	inline static std::array<byte, MAX_MAP_CLUSTERS / 8> s_pvs{}; // static PVS array for PVS functions
 
@@ -993,17 +1065,13 @@ private:
 	void UpdateBlockedFromNavBlockers( void );					// checks if nav blockers are still blocking the area
 
 	bool m_isUnderwater;										// true if the center of the area is underwater
+	NavAreaStaticAttributes m_staticAttributes;					// static geometry attributes
 
 	bool m_isBattlefront;
 
 	float m_avoidanceObstacleHeight;							// if nonzero, a prop is obstructing movement through this nav area
 	CountdownTimer m_avoidanceObstacleTimer;					// Throttle checks on our obstructed state while obstructed
 
-	/* Area Danger */
-	std::array<float, NAV_TEAMS_ARRAY_SIZE> m_danger;			// How dangerous this area is for a given team
-	// Decay danger for this area
-	void DecayDanger();
-
 	//- hiding spots ------------------------------------------------------------------------------------
 	HidingSpotVector m_hidingSpots;
 	bool IsHidingSpotCollision( const Vector &pos ) const;		// returns true if an existing hiding spot is too close to given position
@@ -0,0 +1,316 @@
+#include NAVBOT_PCH_FILE
+#include <algorithm>
+#include <extension.h>
+#include <util/hotpath_profiler.h>
+#include "nav_area.h"
+#include "nav_ladder.h"
+#include "nav_pathfind.h"
+#include "nav_danger_map.h"
+
+#ifdef EXT_VPROF_ENABLED
+#include <tier0/vprof.h>
+#endif // EXT_VPROF_ENABLED
+
+static ConVar sm_nav_danger_decay_rate("sm_nav_danger_decay_rate", "20", FCVAR_GAMEDLL, "How much area danger is decayed per second.", true, 1.0f, true, 100.0f);
+
+namespace
+{
+	// Search node of the danger spread
+	struct DangerSpreadNode
+	{
+		DangerSpreadNode()
+		{
+			remaining = 0.0f;
+			source = 0U;
+			closed = false;
+		}
+
+		float remaining; // travel distance left before reaching the travel limit of the source
+		std::size_t source; // index of the source that reached this area with the most travel distance left
+		bool closed;
+	};
+}
+
+CNavDangerMap::CNavDangerMap()
+{
+	m_pending.reserve(32);
+	m_sources.reserve(32);
+	m_epochs.fill(1U);
+}
+
+void CNavDangerMap::Clear()
+{
+	for (auto& cells : m_cells)
+	{
+		cells.clear();
+	}
+
+	for (auto& epoch : m_epochs)
+	{
+		epoch++;
+	}
+
+	m_pending.clear();
+}
+
+float CNavDangerMap::GetDanger(unsigned int id, int teamID) const
+{
+	if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
+	{
+		return 0.0f;
+	}
+
+	const std::vector<Cell>& cells = m_cells[teamID];
+
+	if (id >= cells.size())
+	{
+		return 0.0f;
+	}
+
+	return GetDecayedValue(cells[id], gpGlobals->curtime);
+}
+
+void CNavDangerMap::IncreaseDanger(unsigned int id, int teamID, float amount, float limit)
+{
+	const float now = gpGlobals->curtime;
+
+	if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
+	{
+		for (std::size_t team = 0U; team < NAV_TEAMS_ARRAY_SIZE; team++)
+		{
+			IncreaseTeamDanger(id, team, amount, limit, now);
+		}
+
+		return;
+	}
+
+	IncreaseTeamDanger(id, static_cast<std::size_t>(teamID), amount, limit, now);
+}
+
+void CNavDangerMap::ClearDanger(unsigned int id, int teamID)
+{
+	for (std::size_t team = 0U; team < NAV_TEAMS_ARRAY_SIZE; team++)
+	{
+		if (teamID >= 0 && teamID < static_cast<int>(NAV_TEAMS_ARRAY_SIZE) && team != static_cast<std::size_t>(teamID))
+		{
+			continue;
+		}
+
+		if (id < m_cells[team].size())
+		{
+			m_cells[team][id].value = 0.0f;
+			m_epochs[team]++;
+		}
+	}
+}
+
+void CNavDangerMap::QueueSpread(CNavArea* start, int teamID, float travelLimit, float danger, float maxDanger)
+{
+	if (start == nullptr)
+	{
+		return;
+	}
+
+	if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
+	{
+		teamID = NAV_TEAM_ANY;
+	}
+
+	m_pending.push_back({ start, teamID, travelLimit, danger, maxDanger });
+}
+
+void CNavDangerMap::Update()
+{
+	if (m_pending.empty())
+	{
+		return;
+	}
+
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CNavDangerMap::Update", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	NAVBOT_PROFILE_SCOPE("CNavDangerMap::Update");
+
+	// one search per team, the last entry is for requests affecting all teams
+	std::array<bool, NAV_TEAMS_ARRAY_SIZE + 1U> teams;
+	teams.fill(false);
+
+	for (const SpreadRequest& request : m_pending)
+	{
+		teams[request.teamID == NAV_TEAM_ANY ? ALL_TEAMS_INDEX : static_cast<std::size_t>(request.teamID)] = true;
+	}
+
+	for (std::size_t i = 0U; i < teams.size(); i++)
+	{
+		if (teams[i])
+		{
+			RunSpread(i == ALL_TEAMS_INDEX ? NAV_TEAM_ANY : static_cast<int>(i));
+		}
+	}
+
+	m_pending.clear();
+}
+
+float CNavDangerMap::GetDecayedValue(const Cell& cell, float now)
+{
+	if (cell.value <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// the clock restarts on map change
+	const float elapsed = std::max(now - cell.timestamp, 0.0f);
+	return std::max(cell.value - elapsed * sm_nav_danger_decay_rate.GetFloat(), 0.0f);
+}
+
+void CNavDangerMap::IncreaseTeamDanger(unsigned int id, std::size_t team, float amount, float limit, float now)
+{
+	std::vector<Cell>& cells = m_cells[team];
+
+	if (id >= cells.size())
+	{
+		const std::size_t size = std::max(static_cast<std::size_t>(id) + 1U, cells.size() * 2U);
+		cells.resize(size, { 0.0f, 0.0f });
+	}
+
+	Cell& cell = cells[id];
+	const float current = GetDecayedValue(cell, now);
+	float value = current + amount;
+
+	if (limit > 0.0f && value > limit)
+	{
+		// don't go over the limit but never reduce existing danger
+		value = std::max(current, limit);
+	}
+
+	cell.value = value;
+	cell.timestamp = now;
+	m_epochs[team]++;
+}
+
+void CNavDangerMap::RunSpread(int teamID)
+{
+	m_sources.clear();
+
+	// requests from the same area are merged
+	for (const SpreadRequest& request : m_pending)
+	{
+		if (request.teamID != teamID)
+		{
+			continue;
+		}
+
+		auto it = std::find_if(m_sources.begin(), m_sources.end(), [&request](const SpreadRequest& source) { return source.start == request.start; });
+
+		if (it != m_sources.end())
+		{
+			it->danger += request.danger;
+			it->travelLimit = std::max(it->travelLimit, request.travelLimit);
+			it->maxDanger = std::max(it->maxDanger, request.maxDanger);
+		}
+		else
+		{
+			m_sources.push_back(request);
+		}
+	}
+
+	/*
+	 * Multi source Dijkstra ordered by the travel distance left. Every source starts with its travel limit and an area is reached by
+	 * the source with the most distance left, which is the source whose danger is applied to the area.
+	 */
+	NavSearchArenaHandle<DangerSpreadNode, NavSearchOpenEntry<CNavArea>> handle;
+	NavSearchArena<DangerSpreadNode, NavSearchOpenEntry<CNavArea>>* arena = handle.Get();
+	std::vector<NavSearchOpenEntry<CNavArea>>& openList = arena->GetOpenList();
+
+	for (std::size_t i = 0U; i < m_sources.size(); i++)
+	{
+		const SpreadRequest& source = m_sources[i];
+		DangerSpreadNode* node = arena->GetNode(source.start->GetID());
+
+		if (node == nullptr)
+		{
+			node = arena->CreateNode(source.start->GetID());
+		}
+		else if (node->remaining >= source.travelLimit)
+		{
+			continue;
+		}
+
+		node->remaining = source.travelLimit;
+		node->source = i;
+		openList.push_back({ -source.travelLimit, source.start });
+		std::push_heap(openList.begin(), openList.end());
+	}
+
+	while (!openList.empty())
+	{
+		std::pop_heap(openList.begin(), openList.end());
+		const NavSearchOpenEntry<CNavArea> entry = openList.back();
+		openList.pop_back();
+
+		CNavArea* area = entry.area;
+		DangerSpreadNode* node = arena->GetNode(area->GetID());
+
+		// outdated heap entry
+		if (node->closed || -entry.total != node->remaining)
+		{
+			continue;
+		}
+
+		node->closed = true;
+
+		// copy since creating nodes may move them
+		const float remaining = node->remaining;
+		const std::size_t sourceIndex = node->source;
+		const SpreadRequest& source = m_sources[sourceIndex];
+		IncreaseDanger(area->GetID(), teamID, source.danger, source.maxDanger);
+
+		if (area->IsBlocked(teamID))
+		{
+			continue;
+		}
+
+		auto func = [&arena, &openList, &area, remaining, sourceIndex](CNavArea* other, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator) {
+			float cost = 0.0f;
+
+			if (link != nullptr)
+			{
+				cost = link->GetConnectionLength();
+			}
+			else if (ladder != nullptr)
+			{
+				cost = ladder->m_length;
+			}
+			else
+			{
+				cost = (other->GetCenter() - area->GetCenter()).Length();
+			}
+
+			const float left = remaining - cost;
+
+			if (left < 0.0f)
+			{
+				return;
+			}
+
+			DangerSpreadNode* othernode = arena->GetNode(other->GetID());
+
+			if (othernode == nullptr)
+			{
+				othernode = arena->CreateNode(other->GetID());
+			}
+			else if (othernode->closed || othernode->remaining >= left)
+			{
+				return;
+			}
+
+			othernode->remaining = left;
+			othernode->source = sourceIndex;
+			openList.push_back({ -left, other });
+			std::push_heap(openList.begin(), openList.end());
+		};
+
+		area->ForEachConnection(func);
+	}
+}
@@ -0,0 +1,98 @@
+#ifndef NAV_MESH_DANGER_MAP_H_
+#define NAV_MESH_DANGER_MAP_H_
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include "nav_consts.h"
+
+class CNavArea;
+
+/**
+ * @brief Per team nav area danger.
+ *
+ * Danger is stored in dense per team arrays indexed by the area ID. Decay is lazy: each value stores the time it was last written
+ * and the decay since then is applied when it is read, nothing is touched on idle frames.
+ * Danger spread requests are queued and processed once per frame with a single bounded multi source search per team.
+ */
+class CNavDangerMap
+{
+public:
+	CNavDangerMap();
+
+	// Removes all danger and pending spread requests.
+	void Clear();
+	/**
+	 * @brief Gets the current danger of an area.
+	 * @param id Area ID.
+	 * @param teamID Team index.
+	 * @return Danger value with decay applied. 0 for invalid teams.
+	 */
+	float GetDanger(unsigned int id, int teamID) const;
+	/**
+	 * @brief Increases the danger of an area.
+	 * @param id Area ID.
+	 * @param teamID Team index, NAV_TEAM_ANY for all teams.
+	 * @param amount Amount to add.
+	 * @param limit Danger is not increased above this limit. Negative for no limit.
+	 */
+	void IncreaseDanger(unsigned int id, int teamID, float amount, float limit = -1.0f);
+	/**
+	 * @brief Clears the danger of an area.
+	 * @param id Area ID.
+	 * @param teamID Team index, NAV_TEAM_ANY for all teams.
+	 */
+	void ClearDanger(unsigned int id, int teamID);
+	/**
+	 * @brief Queues a danger spread. The danger is added to every area within the travel limit of the start area on the next update.
+	 * @param start Start area.
+	 * @param teamID Team index, NAV_TEAM_ANY for all teams.
+	 * @param travelLimit Maximum travel distance from the start area.
+	 * @param danger Danger amount to add.
+	 * @param maxDanger Danger is not increased above this limit.
+	 */
+	void QueueSpread(CNavArea* start, int teamID, float travelLimit, float danger, float maxDanger);
+	// Processes the queued danger spreads.
+	void Update();
+
+	std::size_t GetPendingSpreadCount() const { return m_pending.size(); }
+	// Incremented every time the danger of the given team is written. Always 0 for invalid teams.
+	unsigned int GetEpoch(int teamID) const
+	{
+		if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
+		{
+			return 0U;
+		}
+
+		return m_epochs[teamID];
+	}
+
+private:
+	struct Cell
+	{
+		float value;
+		float timestamp; // time the value was written
+	};
+
+	struct SpreadRequest
+	{
+		CNavArea* start;
+		int teamID;
+		float travelLimit;
+		float danger;
+		float maxDanger;
+	};
+
+	static constexpr std::size_t ALL_TEAMS_INDEX = static_cast<std::size_t>(NAV_TEAMS_ARRAY_SIZE);
+
+	std::array<std::vector<Cell>, NAV_TEAMS_ARRAY_SIZE> m_cells; // indexed by area ID, allocated on the first write
+	std::array<unsigned int, NAV_TEAMS_ARRAY_SIZE> m_epochs; // per team write counter
+	std::vector<SpreadRequest> m_pending;
+	std::vector<SpreadRequest> m_sources; // buffer of merged requests for a single search
+
+	static float GetDecayedValue(const Cell& cell, float now);
+	void IncreaseTeamDanger(unsigned int id, std::size_t team, float amount, float limit, float now);
+	void RunSpread(int teamID);
+};
+
+#endif // !NAV_MESH_DANGER_MAP_H_
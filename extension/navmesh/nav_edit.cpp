@@ -640,6 +640,8 @@ void CNavMesh::OnEditModeStart( void )
  */
 void CNavMesh::OnEditModeEnd( void )
 {
+	// attributes may have changed
+	BuildActiveAreaList();
 }
 
 
@@ -4289,6 +4291,7 @@ void CNavMesh::OnEditDestroyNotify( CNavArea *deadArea )
 
 	OnAvoidanceObstacleLeftArea(deadArea);
 	m_blockedAreas.FindAndRemove( deadArea );
+	RemoveActiveArea(deadArea);
 
 	{
 		auto it = std::remove(std::begin(m_transientAreas), std::end(m_transientAreas), deadArea);
@@ -5191,6 +5194,16 @@ CON_COMMAND_F(sm_nav_dump_as_keyvalues, "Dumps nav mesh data to a keyvalues file
 	TheNavMesh->CommandNavDumpToKeyValues();
 }
 
+CON_COMMAND_F(sm_nav_validate, "Checks the nav mesh for broken connections, duplicate IDs and degenerate areas.", FCVAR_GAMEDLL | FCVAR_CHEAT)
+{
+	TheNavMesh->CommandNavValidate();
+}
+
+CON_COMMAND_F(sm_nav_stats, "Prints nav mesh statistics: area count, connection degree distribution and connected components.", FCVAR_GAMEDLL)
+{
+	TheNavMesh->CommandNavStats();
+}
+
 CON_COMMAND_F(sm_nav_highlight_unnamed_areas, "Highlights unnamed areas.", FCVAR_GAMEDLL | FCVAR_CHEAT)
 {
 	if (extmanager->GetListenServerHost() == nullptr)
@@ -5358,6 +5371,157 @@ CON_COMMAND_F(sm_nav_area_print_positions, "Prints the coordinates of nav areas.
 	TheNavMesh->ExecuteAreaEditCommand<CNavArea>(func);
 }
 
+void CNavMesh::CommandNavValidate()
+{
+	if (!IsLoaded())
+	{
+		META_CONPRINT("No nav mesh loaded! \n");
+		return;
+	}
+
+	int errors = ValidateNavAreaConnections();
+	std::unordered_set<unsigned int> ids;
+	ids.reserve(static_cast<std::size_t>(TheNavAreas.Count()));
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+
+		if (!ids.insert(area->GetID()).second)
+		{
+			META_CONPRINTF("Area #%u: duplicate ID! \n", area->GetID());
+			errors++;
+		}
+
+		if (area->GetSizeX() < 1.0f || area->GetSizeY() < 1.0f)
+		{
+			META_CONPRINTF("Area #%u: degenerate area (size %g x %g)! \n", area->GetID(), area->GetSizeX(), area->GetSizeY());
+			errors++;
+		}
+	}
+
+	int warnings = 0;
+
+	for (CNavLadder* ladder : m_ladders)
+	{
+		if (ladder->GetConnectionsCount() == 0)
+		{
+			META_CONPRINTF("Ladder #%u: not connected to any area. \n", ladder->GetID());
+			warnings++;
+		}
+	}
+
+	META_CONPRINTF("Nav mesh validation finished with %i errors and %i warnings. \n", errors, warnings);
+}
+
+void CNavMesh::CommandNavStats() const
+{
+	if (!IsLoaded())
+	{
+		META_CONPRINT("No nav mesh loaded! \n");
+		return;
+	}
+
+	constexpr int MAX_DEGREE = 12; // degrees past this share the last bucket
+	const int areaCount = TheNavAreas.Count();
+	std::unordered_map<const CNavArea*, int> indexes;
+	indexes.reserve(static_cast<std::size_t>(areaCount));
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		indexes[TheNavAreas[it]] = it;
+	}
+
+	// union-find, components are computed on the undirected connection graph
+	std::vector<int> parents(static_cast<std::size_t>(areaCount));
+
+	for (int i = 0; i < areaCount; i++)
+	{
+		parents[i] = i;
+	}
+
+	auto find = [&parents](int i) -> int {
+		while (parents[i] != i)
+		{
+			parents[i] = parents[parents[i]];
+			i = parents[i];
+		}
+
+		return i;
+	};
+
+	std::array<int, MAX_DEGREE + 1> degrees{};
+	std::size_t connections = 0;
+	std::size_t oneway = 0;
+	int isolated = 0;
+	int maxDegree = 0;
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+		int degree = 0;
+
+		auto functor = [&](CNavArea* other) {
+			degree++;
+
+			if (!other->IsConnected(area, NUM_DIRECTIONS))
+			{
+				oneway++;
+			}
+
+			auto index = indexes.find(other);
+
+			if (index != indexes.end())
+			{
+				parents[find(it)] = find(index->second);
+			}
+		};
+
+		area->ForEachConnectedArea(functor);
+
+		connections += static_cast<std::size_t>(degree);
+		maxDegree = std::max(maxDegree, degree);
+		degrees[std::min(degree, MAX_DEGREE)]++;
+
+		if (degree == 0 && area->GetIncomingConnections(NORTH)->Count() == 0 && area->GetIncomingConnections(SOUTH)->Count() == 0 &&
+			area->GetIncomingConnections(EAST)->Count() == 0 && area->GetIncomingConnections(WEST)->Count() == 0)
+		{
+			isolated++;
+		}
+	}
+
+	std::unordered_map<int, int> components;
+
+	for (int i = 0; i < areaCount; i++)
+	{
+		components[find(i)]++;
+	}
+
+	int largest = 0;
+
+	for (auto& pair : components)
+	{
+		largest = std::max(largest, pair.second);
+	}
+
+	META_CONPRINT("--- Nav Mesh Statistics --- \n");
+	META_CONPRINTF("Areas: %i \nLadders: %i \nElevators: %zu \nWaypoints: %zu \n", areaCount, m_ladders.Count(), m_elevators.size(), m_waypoints.size());
+	META_CONPRINTF("Grid: %i x %i cells of %g units \n", m_gridSizeX, m_gridSizeY, m_gridCellSize);
+	META_CONPRINTF("Outgoing connections: %zu (%zu one-way) \n", connections, oneway);
+	META_CONPRINTF("Average degree: %3.2f \nMax degree: %i \nIsolated areas: %i \n", areaCount > 0 ? static_cast<float>(connections) / static_cast<float>(areaCount) : 0.0f, maxDegree, isolated);
+	META_CONPRINT("Degree distribution: \n");
+
+	for (int i = 0; i <= MAX_DEGREE; i++)
+	{
+		if (degrees[i] > 0)
+		{
+			META_CONPRINTF("  %2i%s: %i \n", i, i == MAX_DEGREE ? "+" : " ", degrees[i]);
+		}
+	}
+
+	META_CONPRINTF("Connected components: %zu (largest has %i areas) \n", components.size(), largest);
+}
+
 void CNavMesh::RegisterCommands()
 {
 	// Call the virtual one for derived classes
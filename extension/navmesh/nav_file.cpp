@@ -383,6 +383,14 @@ void CNavArea::Save(std::fstream& filestream, uint32_t version)
 		Vector end = link.m_end;
 		filestream.write(reinterpret_cast<char*>(&end), sizeof(Vector));
 	}
+
+	// save static attributes
+	if (!m_staticAttributes.isValid)
+	{
+		ComputeStaticAttributes();
+	}
+
+	filestream.write(reinterpret_cast<char*>(&m_staticAttributes.groundNormal), sizeof(Vector));
 }
 
 
@@ -551,6 +559,21 @@ NavErrorType CNavArea::Load(std::fstream& filestream, uint32_t version, uint32_t
 		m_offmeshconnections.emplace_back(type, id, start, end);
 	}
 
+	// Load static attributes, older files computes them on first access
+	constexpr uint32_t STATIC_ATTRIBUTES_VERSION = 2U;
+
+	if (version >= STATIC_ATTRIBUTES_VERSION)
+	{
+		filestream.read(reinterpret_cast<char*>(&m_staticAttributes.groundNormal), sizeof(Vector));
+
+		if (!filestream.good())
+		{
+			return NAV_CORRUPT_DATA;
+		}
+
+		m_staticAttributes.isValid = true;
+	}
+
 	return NAV_OK;
 }
 
@@ -1613,6 +1636,8 @@ NavErrorType CNavMesh::PostLoad( uint32_t version )
 {
 	NavErrorType error = NAV_OK;
 
+	m_reachability.Invalidate();
+
 	// allow areas to connect to each other, etc
 	FOR_EACH_VEC( TheNavAreas, pit )
 	{
@@ -13,6 +13,9 @@
 #include <algorithm>
 #include <vector>
 #include <unordered_set>
+#include <cmath>
+#include <atomic>
+#include <thread>
 
 #include <extension.h>
 #include <manager.h>
@@ -45,8 +48,8 @@ static unsigned int blockedID[ MAX_BLOCKED_AREAS ];
 static int blockedIDCount = 0;
 static float lastMsgTime = 0.0f;
 
-bool TraceAdjacentNode(int depth, const Vector& start, const Vector& end, trace_t* trace, float zLimit = navgenparams->death_drop );
-bool StayOnFloor( trace_t *trace, float zLimit = navgenparams->death_drop);
+bool TraceAdjacentNode(int depth, const Vector& start, const Vector& end, trace_t* trace, float zLimit = navgenparams->death_drop, ITraceFilter* filter = nullptr );
+bool StayOnFloor( trace_t *trace, float zLimit = navgenparams->death_drop, ITraceFilter* filter = nullptr );
 
 ConVar sm_nav_slope_limit( "sm_nav_slope_limit", "0.7", FCVAR_CHEAT, "The ground unit normal's Z component must be greater than this for nav areas to be generated." );
 ConVar sm_nav_slope_tolerance( "sm_nav_slope_tolerance", "0.1", FCVAR_CHEAT, "The ground unit normal's Z component must be this close to the nav area's Z component to be generated." );
@@ -57,6 +60,8 @@ ConVar sm_nav_generate_incremental_range( "sm_nav_generate_incremental_range", "
 ConVar sm_nav_generate_incremental_tolerance( "sm_nav_generate_incremental_tolerance", "0", FCVAR_CHEAT, "Z tolerance for adding new nav areas." );
 // Original valve nav mesh uses 50. TF2C reduced to 10. Never asked why but it does look better with 10.
 ConVar sm_nav_area_max_size( "sm_nav_area_max_size", "10", FCVAR_CHEAT, "Max area size created in nav generation" );
+static ConVar sm_nav_generate_threads("sm_nav_generate_threads", "0", FCVAR_CHEAT, "If greater than zero, full generations sample the walkable space on this many worker threads. World only traces are used, static props and entities are ignored while sampling.", true, 0.0f, true, 64.0f);
+static ConVar sm_nav_generate_tile_size("sm_nav_generate_tile_size", "1024", FCVAR_CHEAT, "Size of the tiles the map is split into when sampling the walkable space on worker threads.", true, 128.0f, false, 0.0f);
 static ConVar sm_nav_prefer_reload("sm_nav_prefer_reload", "1", FCVAR_GAMEDLL, "(Experimental) If enabled, reloads the navigation mesh instead of reloading the entire map.");
 
 constexpr float MaxTraversableHeight = 18.0f;		// max internal obstacle height that can occur between nav nodes and safely disregarded
@@ -1663,7 +1668,7 @@ public:
  */
 void CNavMesh::StitchGeneratedAreas( void )
 {
-	if ( m_generationMode == GENERATE_INCREMENTAL )
+	if ( m_generationMode == GENERATE_INCREMENTAL || m_generationMode == GENERATE_REGION )
 	{
 		IncrementallyGeneratedAreas incrementalAreas;
 		StitchMesh( incrementalAreas );
@@ -2023,14 +2028,36 @@ void CNavMesh::MergeGeneratedAreas( void )
 
 	bool merged;
 
+	// Only areas with nodes can be merged, collect them once so region generates don't rescan the whole mesh after every merge.
+	std::vector<CNavArea*> candidates;
+	candidates.reserve( TheNavAreas.Count() );
+
+	FOR_EACH_VEC( TheNavAreas, it )
+	{
+		if ( TheNavAreas[ it ]->HasNodes() )
+		{
+			candidates.push_back( TheNavAreas[ it ] );
+		}
+	}
+
+	// the merged area is destroyed
+	auto removeCandidate = [&candidates]( CNavArea *mergedArea ) {
+		auto cit = std::find( candidates.begin(), candidates.end(), mergedArea );
+
+		if ( cit != candidates.end() )
+		{
+			candidates.erase( cit );
+		}
+	};
+
 	do
 	{
 		merged = false;
 
-		FOR_EACH_VEC( TheNavAreas, it )
+		for ( std::size_t it = 0; it < candidates.size(); it++ )
 		{
-			CNavArea *area = TheNavAreas[ it ];
-			if ( !area->HasNodes() || ( area->GetAttributes() & NAV_MESH_NO_MERGE ) ) 
+			CNavArea *area = candidates[ it ];
+			if ( area->GetAttributes() & NAV_MESH_NO_MERGE ) 
 				continue;
 
 			// north edge
@@ -2054,6 +2081,7 @@ void CNavMesh::MergeGeneratedAreas( void )
 					//CONSOLE_ECHO( "  Merged (north) areas #%d and #%d\n", area->m_id, adjArea->m_id );
 
 					area->FinishMerge( this, adjArea );
+					removeCandidate( adjArea );
 
 					// restart scan - iterator is invalidated
 					break;
@@ -2084,6 +2112,7 @@ void CNavMesh::MergeGeneratedAreas( void )
 					//CONSOLE_ECHO( "  Merged (south) areas #%d and #%d\n", area->m_id, adjArea->m_id );
 
 					area->FinishMerge( this, adjArea );
+					removeCandidate( adjArea );
 
 					// restart scan - iterator is invalidated
 					break;
@@ -2116,6 +2145,7 @@ void CNavMesh::MergeGeneratedAreas( void )
 					//CONSOLE_ECHO( "  Merged (west) areas #%d and #%d\n", area->m_id, adjArea->m_id );
 
 					area->FinishMerge( this, adjArea );
+					removeCandidate( adjArea );
 
 					// restart scan - iterator is invalidated
 					break;
@@ -2147,6 +2177,7 @@ void CNavMesh::MergeGeneratedAreas( void )
 					//CONSOLE_ECHO( "  Merged (east) areas #%d and #%d\n", area->m_id, adjArea->m_id );
 
 					area->FinishMerge( this, adjArea );
+					removeCandidate( adjArea );
 
 					// restart scan - iterator is invalidated
 					break;
@@ -2465,6 +2496,11 @@ void CNavMesh::SplitAreasUnderOverhangs( void )
 				for ( int iConnection = 0; iConnection < pConnections->Count() && !bRestartProcessing; iConnection++ )
 				{
 					CNavArea *otherArea = (*pConnections)[iConnection].area;
+
+					// when generating a region, only the new areas (the ones with nodes) and the areas they overhang need to be checked
+					if ( m_generationMode == GENERATE_REGION && !area->HasNodes() && !otherArea->HasNodes() )
+						continue;
+
 					Extent otherAreaExtent;
 					otherArea->GetExtent( &otherAreaExtent );
 
@@ -3006,7 +3042,7 @@ bool CNavMesh::TestArea(CNavNode* node, int width, int height)
 		vertNode = vertNode->GetConnectedNode(SOUTH);
 	}
 
-	if (m_generationMode == GENERATE_INCREMENTAL)
+	if (m_generationMode == GENERATE_INCREMENTAL || m_generationMode == GENERATE_REGION)
 	{
 		// Incremental generation needs to check that it's not overlapping existing areas...
 		const Vector* nw = node->GetPosition();
@@ -3225,6 +3261,18 @@ void CNavMesh::CreateNavAreasFromNodes( void )
 	// add the areas to the grid
 	AllocateGrid( extent.lo.x, extent.hi.x, extent.lo.y, extent.hi.y );
 
+	// Region and incremental generation keep the existing areas, which are still registered. AllocateGrid only clears the grid, clear the
+	// other registrations too so AddNavArea doesn't link an area to itself in the hash table or count it twice.
+	for ( int i = 0; i < HASH_TABLE_SIZE; ++i )
+	{
+		m_hashTable[i] = NULL;
+	}
+
+	m_areaCount = 0;
+	m_transientAreas.clear();
+	m_activeAreas.clear();
+	m_activeAreaCursor = 0U;
+
 	FOR_EACH_VEC( TheNavAreas, git )
 	{
 		AddNavArea( TheNavAreas[ git ] );
@@ -3243,7 +3291,18 @@ void CNavMesh::CreateNavAreasFromNodes( void )
 	FixUpGeneratedAreas();
 
 	/// @TODO: incremental generation doesn't create ladders yet
-	if ( m_generationMode != GENERATE_INCREMENTAL )
+	if ( m_generationMode == GENERATE_REGION )
+	{
+		// only reconnect ladders that lost their areas
+		for ( int i=0; i<m_ladders.Count(); ++i )
+		{
+			if ( m_simplifyGenerationExtent.Contains( m_ladders[i]->m_bottom ) || m_simplifyGenerationExtent.Contains( m_ladders[i]->m_top ) )
+			{
+				m_ladders[i]->ConnectGeneratedLadder( 0.0f );
+			}
+		}
+	}
+	else if ( m_generationMode != GENERATE_INCREMENTAL )
 	{
 		for ( int i=0; i<m_ladders.Count(); ++i )
 		{
@@ -3558,6 +3617,14 @@ bool CNavMesh::UpdateGeneration( float maxTime )
 		//---------------------------------------------------------------------------
 		case SAMPLE_WALKABLE_SPACE:
 		{
+			if ( m_generationMode == GENERATE_FULL && sm_nav_generate_threads.GetInt() > 0 )
+			{
+				// offline mode, blocks until the whole map has been sampled
+				SampleWalkableSpaceParallel( sm_nav_generate_threads.GetInt() );
+				m_generationState = CREATE_AREAS_FROM_SAMPLES;
+				return true;
+			}
+
 			AnalysisProgress( "Sampling walkable space...", 100, m_sampleTick / 10, false );
 			m_sampleTick = ( m_sampleTick + 1 ) % 1000;
 
@@ -3849,6 +3916,7 @@ bool CNavMesh::UpdateGeneration( float maxTime )
 			}
 			while( m_generationIndex < TheNavAreas.Count() )
 			{
+				TheNavAreas[ m_generationIndex ]->ComputeStaticAttributes();
 				TheNavAreas[ m_generationIndex++ ]->CustomAnalysis( m_generationMode == GENERATE_INCREMENTAL );
 
 				// don't go over our time allotment
@@ -3959,7 +4027,7 @@ bool CNavMesh::UpdateGeneration( float maxTime )
  * Node Z positions are ground level.
  */
 CNavNode *CNavMesh::AddNode( const Vector &destPos, const Vector &normal, NavDirType dir, CNavNode *source, bool isOnDisplacement, 
-							float obstacleHeight, float obstacleStartDist, float obstacleEndDist )
+							float obstacleHeight, float obstacleStartDist, float obstacleEndDist, bool checkCrouch )
 {
 	// check if a node exists at this location
 	CNavNode *node = CNavNode::GetNode( destPos );
@@ -3995,7 +4063,11 @@ CNavNode *CNavMesh::AddNode( const Vector &destPos, const Vector &normal, NavDir
 		m_currentNode = node;
 	}
 
-	node->CheckCrouch();
+	if ( checkCrouch )
+	{
+		node->CheckCrouch();
+	}
+
 	return node;
 }
 
@@ -4083,13 +4155,19 @@ static void DrawTrace( const trace_t *trace )
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool StayOnFloor( trace_t *trace, float zLimit /* = DeathDrop */ )
+bool StayOnFloor( trace_t *trace, float zLimit /* = DeathDrop */, ITraceFilter* filter /* = nullptr */ )
 {
 	Vector end( trace->endpos );
 	end.z -= zLimit;
 
-	CTraceFilterWalkableEntities filter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
-	trace::hull(trace->endpos, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, *trace);
+	CTraceFilterWalkableEntities walkableFilter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
+
+	if ( filter == nullptr )
+	{
+		filter = &walkableFilter;
+	}
+
+	trace::hull(trace->endpos, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), filter, *trace);
 
 	DrawTrace( trace );
 	return !trace->startsolid && trace->fraction < 1.0f
@@ -4098,12 +4176,18 @@ bool StayOnFloor( trace_t *trace, float zLimit /* = DeathDrop */ )
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool TraceAdjacentNode( int depth, const Vector& start, const Vector& end, trace_t *trace, float zLimit /* = DeathDrop */ )
+bool TraceAdjacentNode( int depth, const Vector& start, const Vector& end, trace_t *trace, float zLimit /* = DeathDrop */, ITraceFilter* filter /* = nullptr */ )
 {
 	const float MinDistance = 1.0f;	// if we can't move at least this far, don't bother stepping up.
 
-	CTraceFilterWalkableEntities filter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
-	trace::hull(start, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, *trace);
+	CTraceFilterWalkableEntities walkableFilter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
+
+	if ( filter == nullptr )
+	{
+		filter = &walkableFilter;
+	}
+
+	trace::hull(start, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), filter, *trace);
 	DrawTrace( trace );
 
 	// If we started in the ground for some reason, bail
@@ -4113,13 +4197,13 @@ bool TraceAdjacentNode( int depth, const Vector& start, const Vector& end, trace
 	// If we made it, so try to find the floor
 	if ( end.x == trace->endpos.x && end.y == trace->endpos.y )
 	{
-		return StayOnFloor( trace, zLimit );
+		return StayOnFloor( trace, zLimit, filter );
 	}
 
 	// If we didn't make enough progress, bail
 	if ( (depth && start.AsVector2D().DistToSqr( trace->endpos.AsVector2D() ) < MinDistance * MinDistance)
 	// We made it more than MinDistance.  If the slope is too steep, we can't go on.
-			|| !StayOnFloor( trace, zLimit ) )
+			|| !StayOnFloor( trace, zLimit, filter ) )
 	{
 		return false;
 	}
@@ -4127,17 +4211,17 @@ bool TraceAdjacentNode( int depth, const Vector& start, const Vector& end, trace
 	// Try to go up as if we stepped up, forward, and down.
 	Vector testEnd( trace->endpos );
 	testEnd.z += navgenparams->step_height;
-	trace::hull(trace->endpos, testEnd, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, *trace);
+	trace::hull(trace->endpos, testEnd, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), filter, *trace);
 	DrawTrace( trace );
 
 	Vector forwardTestEnd = end;
 	forwardTestEnd.z = trace->endpos.z;
-	return TraceAdjacentNode( depth+1, trace->endpos, forwardTestEnd, trace );
+	return TraceAdjacentNode( depth+1, trace->endpos, forwardTestEnd, trace, navgenparams->death_drop, filter );
 }
 
 
 //--------------------------------------------------------------------------------------------------------
-static bool IsNodeOverlapped( const Vector& pos, const Vector& offset )
+static bool IsNodeOverlapped( const Vector& pos, const Vector& offset, ITraceFilter* filter )
 {
 	bool overlap = TheNavMesh->GetNavArea( pos + offset, navgenparams->human_height ) != NULL;
 	if ( !overlap )
@@ -4151,8 +4235,7 @@ static bool IsNodeOverlapped( const Vector& pos, const Vector& offset )
 		end.x += offset.x * navgenparams->generation_step_size;
 		end.y += offset.y * navgenparams->generation_step_size;
 		trace_t trace;
-		CTraceFilterWalkableEntities filter( nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING );
-		trace::hull(start, end, mins, maxs, TheNavMesh->GetGenerationTraceMask(), &filter, trace);
+		trace::hull(start, end, mins, maxs, TheNavMesh->GetGenerationTraceMask(), filter, trace);
 		if ( trace.startsolid || trace.allsolid
 				|| trace.fraction < 0.1f )
 		{
@@ -4161,7 +4244,7 @@ static bool IsNodeOverlapped( const Vector& pos, const Vector& offset )
 
 		start = trace.endpos;
 		end.z -= navgenparams->human_height * 2;
-		trace::hull(start, end, mins, maxs, TheNavMesh->GetGenerationTraceMask(), &filter, trace);
+		trace::hull(start, end, mins, maxs, TheNavMesh->GetGenerationTraceMask(), filter, trace);
 		if ( trace.startsolid || trace.allsolid
 				|| trace.fraction == 1.0f
 				|| trace.plane.normal.z < 0.7f )
@@ -4195,7 +4278,7 @@ bool CNavMesh::SampleStep( void )
 
 			if (m_currentNode == NULL)
 			{
-				if ( m_generationMode == GENERATE_INCREMENTAL || m_generationMode == GENERATE_SIMPLIFY )
+				if ( m_generationMode == GENERATE_INCREMENTAL || m_generationMode == GENERATE_SIMPLIFY || m_generationMode == GENERATE_REGION )
 				{
 					return false;
 				}
@@ -4229,238 +4312,445 @@ bool CNavMesh::SampleStep( void )
 			{
 				// have not searched in this direction yet
 
-				// start at current node position
-				Vector pos = *m_currentNode->GetPosition();
+				m_generationDir = (NavDirType)dir;
+
+				// mark direction as visited
+				m_currentNode->MarkAsVisited( m_generationDir );
 
-				// snap to grid
-				int cx = SnapToGrid( pos.x );
-				int cy = SnapToGrid( pos.y );
+				// test if we can move to new position
+				CTraceFilterWalkableEntities filter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
+				SampleStepResult step;
 
-				// attempt to move to adjacent node
-				switch( dir )
+				if ( TestSampleStep( *m_currentNode->GetPosition(), m_generationDir, &filter, step ) )
 				{
-					case NORTH:		cy -= navgenparams->generation_step_size; break;
-					case SOUTH:		cy += navgenparams->generation_step_size; break;
-					case EAST:		cx += navgenparams->generation_step_size; break;
-					case WEST:		cx -= navgenparams->generation_step_size; break;
+					// we can move here
+					// create a new navigation node, and update current node pointer
+					AddNode( step.to, step.normal, m_generationDir, m_currentNode, step.isOnDisplacement, step.obstacleHeight, step.obstacleStartDist, step.obstacleEndDist );
 				}
 
-				pos.x = cx;
-				pos.y = cy;
+				return true;
+			}
+		}
 
-				m_generationDir = (NavDirType)dir;
+		// all directions have been searched from this node - pop back to its parent and continue
+		m_currentNode = m_currentNode->GetParent();
+	}
+}
 
-				// mark direction as visited
-				m_currentNode->MarkAsVisited( m_generationDir );
+//--------------------------------------------------------------------------------------------------------------
+/**
+ * Runs job(index) for every index in [0, jobCount) on the given number of threads. The calling thread is one of them.
+ */
+template <typename F>
+static void RunSamplingJobs( int numThreads, std::size_t jobCount, F& job )
+{
+	std::atomic<std::size_t> next{ 0U };
 
-				// sanity check to not generate across the world for incremental generation
-				const float incrementalRange = sm_nav_generate_incremental_range.GetFloat();
-				if (m_generationMode == GENERATE_INCREMENTAL && incrementalRange > 0)
-				{
-					bool inRange = false;
+	auto worker = [&next, &job, jobCount]() {
+		for ( std::size_t i = next.fetch_add( 1U ); i < jobCount; i = next.fetch_add( 1U ) )
+		{
+			job( i );
+		}
+	};
 
-					for (const WalkableSeedSpot& spot : m_walkableSeeds)
-					{
-						if ((spot.pos - pos).IsLengthLessThan(incrementalRange))
-						{
-							inRange = true;
-							break;
-						}
-					}
+	const int numWorkers = std::min( numThreads, static_cast<int>( jobCount ) ) - 1;
+	std::vector<std::thread> threads;
+	threads.reserve( std::max( numWorkers, 0 ) );
 
-					if (!inRange)
-					{
-						return true;
-					}
-				}
+	for ( int i = 0; i < numWorkers; ++i )
+	{
+		threads.emplace_back( worker );
+	}
 
-				if ( m_generationMode == GENERATE_SIMPLIFY
-						&& !m_simplifyGenerationExtent.Contains( pos ) )
-				{
-					return true;
-				}
+	worker();
 
-				// test if we can move to new position
-				trace_t result;
-				Vector from( *m_currentNode->GetPosition() );
-				CTraceFilterWalkableEntities filter(nullptr, COLLISION_GROUP_NONE, WALK_THRU_EVERYTHING);
-				Vector to, toNormal;
-				float obstacleHeight = 0, obstacleStartDist = 0, obstacleEndDist = navgenparams->generation_step_size;
-				if ( TraceAdjacentNode( 0, from, pos, &result ) )
-				{
-					to = result.endpos;
-					toNormal = result.plane.normal;
-				}
-				else
-				{
-					// test going up ClimbUpHeight
-					bool success = false;
-					for ( float height = navgenparams->step_height; height <= navgenparams->climb_up_height; height += 1.0f )
-					{						
-						trace_t tr;
-						Vector start( from );
-						Vector end( pos );
-						start.z += height;
-						end.z += height;
-						trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), &filter, tr);
-						if ( !tr.startsolid && tr.fraction == 1.0f )
-						{
-							if ( !StayOnFloor( &tr ) )
-							{
-								break;
-							}
+	for ( std::thread &thread : threads )
+	{
+		thread.join();
+	}
+}
 
-							to = tr.endpos;
-							toNormal = tr.plane.normal;
+//--------------------------------------------------------------------------------------------------------------
+/**
+ * Sample the walkable space of the whole map on worker threads.
+ * The flood fill runs in waves, every unexplored direction of the frontier nodes is a step to test.
+ * Steps are grouped by map tile and each worker tests whole tiles using world only traces, which
+ * don't call into game entities. Results are committed on the main thread in a fixed order, nodes
+ * reached from more than one tile are stitched together by the node hash in AddNode.
+ */
+void CNavMesh::SampleWalkableSpaceParallel( int numThreads )
+{
+	struct SampleTask
+	{
+		CNavNode *node;
+		NavDirType dir;
+		std::uint64_t tile;
+		bool success;
+		SampleStepResult result;
+	};
 
-							start = end = from;
-							end.z += height;
-							trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), &filter, tr);
-							if ( tr.fraction < 1.0f )
-							{
-								break;
-							}
+	const double startTime = Plat_FloatTime();
+	const float tileSize = sm_nav_generate_tile_size.GetFloat();
+	std::vector<SampleTask> tasks;
+	std::vector<std::pair<std::size_t, std::size_t>> tiles; // range of tasks in each tile
+	std::vector<CNavNode *> frontier;
+	std::vector<CNavNode *> newNodes;
+	unsigned int waves = 0;
+
+	auto GetTileKey = [tileSize]( const Vector *pos ) -> std::uint64_t {
+		const std::int32_t x = static_cast<std::int32_t>( std::floor( pos->x / tileSize ) );
+		const std::int32_t y = static_cast<std::int32_t>( std::floor( pos->y / tileSize ) );
+		// shift unsigned values, left shifting a negative signed value is undefined
+		return ( static_cast<std::uint64_t>( static_cast<std::uint32_t>( x ) ) << 32 ) | static_cast<std::uint32_t>( y );
+	};
 
-							// keep track of far up we had to go to find a path to the next node
-							obstacleHeight = height;
-							success = true;
-							break;
-						}
-						else
-						{
-							// Could not trace from node to node at this height, something is in the way.
-							// Trace in the other direction to see if we hit something
-							Vector vecToObstacleStart = tr.endpos - start;
+	auto testTile = [this, &tasks, &tiles]( std::size_t index ) {
+		CTraceFilterWorldOnly filter;
 
-							if ( vecToObstacleStart.LengthSqr() <= Square( navgenparams->generation_step_size ) )
-							{
-								trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), &filter, tr);
-								if ( !tr.startsolid && tr.fraction < 1.0 )
-								{
-									// We hit something going the other direction.  There is some obstacle between the two nodes.
-									Vector vecToObstacleEnd = tr.endpos - start;
-
-									if ( vecToObstacleEnd.LengthSqr() <= Square( navgenparams->generation_step_size )  )
-									{
-										// Remember the distances to start and end of the obstacle (with respect to the "from" node).
-										// Keep track of the last distances to obstacle as we keep increasing the height we do a trace for.
-										// If we do eventually clear the obstacle, these values will be the start and end distance to the
-										// very tip of the obstacle.
-										obstacleStartDist = vecToObstacleStart.Length();
-										obstacleEndDist = vecToObstacleEnd.Length();
-										if ( obstacleEndDist == 0 )
-										{
-											obstacleEndDist = navgenparams->generation_step_size;
-										}
-									}								
-								}
-							}
-						}
-					}
+		for ( std::size_t i = tiles[index].first; i < tiles[index].second; ++i )
+		{
+			SampleTask &task = tasks[i];
+			task.success = TestSampleStep( *task.node->GetPosition(), task.dir, &filter, task.result );
+		}
+	};
 
-					if ( !success )
-					{
-						return true;
-					}
-				}
+	auto checkCrouch = [&newNodes]( std::size_t index ) {
+		CTraceFilterWorldOnly filter;
+		newNodes[index]->CheckCrouch( &filter );
+	};
 
-#if SOURCE_ENGINE >= SE_ORANGEBOX
-				// Don't generate nodes if we spill off the end of the world onto skybox
-				if (result.surface.flags & (SURF_SKY | SURF_SKY2D))
+	while ( m_seedIdx < m_walkableSeeds.size() )
+	{
+		CNavNode *seed = GetNextWalkableSeedNode();
+
+		if ( seed )
+		{
+			frontier.push_back( seed );
+		}
+	}
+
+	while ( true )
+	{
+		while ( !frontier.empty() )
+		{
+			++waves;
+			tasks.clear();
+			tiles.clear();
+			newNodes.clear();
+
+			for ( CNavNode *node : frontier )
+			{
+				for ( int dir = NORTH; dir < NUM_DIRECTIONS; dir++ )
 				{
-					return true;
+					if ( node->HasVisited( (NavDirType)dir ) )
+						continue;
+
+					node->MarkAsVisited( (NavDirType)dir );
+					tasks.push_back( { node, (NavDirType)dir, GetTileKey( node->GetPosition() ), false, {} } );
 				}
-#else
-				// Don't generate nodes if we spill off the end of the world onto skybox
-				if (result.surface.flags & (SURF_SKY))
+			}
+
+			std::stable_sort( tasks.begin(), tasks.end(), []( const SampleTask &lhs, const SampleTask &rhs ) {
+				return lhs.tile < rhs.tile;
+			} );
+
+			for ( std::size_t i = 0; i < tasks.size(); )
+			{
+				std::size_t end = i + 1;
+
+				while ( end < tasks.size() && tasks[end].tile == tasks[i].tile )
 				{
-					return true;
+					++end;
 				}
-#endif // SOURCE_ENGINE >= SE_ORANGEBOX
 
-				// If we're incrementally generating, don't overlap existing nav areas.
-				Vector testPos( to );
-				if ( IsNodeOverlapped( testPos, Vector(  1,  1, navgenparams->human_height ) )
-						&& IsNodeOverlapped( testPos, Vector( -1,  1, navgenparams->human_height ) )
-						&& IsNodeOverlapped( testPos, Vector(  1, -1, navgenparams->human_height ) )
-						&& IsNodeOverlapped( testPos, Vector( -1, -1, navgenparams->human_height ) )
-						&& m_generationMode != GENERATE_SIMPLIFY )
+				tiles.emplace_back( i, end );
+				i = end;
+			}
+
+			RunSamplingJobs( numThreads, tiles.size(), testTile );
+
+			for ( const SampleTask &task : tasks )
+			{
+				if ( !task.success )
+					continue;
+
+				const bool isNew = CNavNode::GetNode( task.result.to ) == nullptr;
+				CNavNode *node = AddNode( task.result.to, task.result.normal, task.dir, task.node, task.result.isOnDisplacement,
+					task.result.obstacleHeight, task.result.obstacleStartDist, task.result.obstacleEndDist, false );
+
+				if ( isNew )
 				{
-					return true;
+					newNodes.push_back( node );
 				}
+			}
 
-				int nTolerance = sm_nav_generate_incremental_tolerance.GetInt();
-				if ( nTolerance > 0 && m_generationMode == GENERATE_INCREMENTAL )
-				{
-					bool bValid = false;
-					int zPos = to.z;
-					for (const WalkableSeedSpot& spot : m_walkableSeeds)
-					{
-						const Vector &seedPos = spot.pos;
-						int zMin = seedPos.z - nTolerance;
-						int zMax = seedPos.z + nTolerance;
+			RunSamplingJobs( numThreads, newNodes.size(), checkCrouch );
 
-						if (zPos >= zMin && zPos <= zMax)
-						{
-							bValid = true;
-							break;
-						}
-					}
+			frontier.swap( newNodes );
 
-					if (!bValid)
-						return true;
+			if ( waves % 100 == 0 )
+			{
+				Msg( "Sampling walkable space... %u nodes\n", CNavNode::GetListLength() );
+			}
+		}
+
+		// search is exhausted - continue search from ends of ladders
+		for ( int i=0; i<m_ladders.Count(); ++i )
+		{
+			CNavLadder *ladder = m_ladders[i];
+			CNavNode *node = LadderEndSearch( &ladder->m_bottom, ladder->GetDir() );
+
+			if ( node == nullptr )
+			{
+				node = LadderEndSearch( &ladder->m_top, ladder->GetDir() );
+			}
+
+			if ( node )
+			{
+				frontier.push_back( node );
+				break;
+			}
+		}
+
+		if ( frontier.empty() )
+		{
+			// all seeds exhausted, sampling complete
+			break;
+		}
+	}
+
+	m_currentNode = nullptr;
+	Msg( "Sampled %u nodes in %u waves using %i threads, %.1f seconds elapsed.\n", CNavNode::GetListLength(), waves, numThreads, Plat_FloatTime() - startTime );
+}
+
+//--------------------------------------------------------------------------------------------------------------
+/**
+ * Test a single sampling step from the given position in the given direction.
+ * This only reads the world and the mesh, which allows it to run on the sampling worker threads.
+ */
+bool CNavMesh::TestSampleStep( const Vector &from, NavDirType dir, ITraceFilter *filter, SampleStepResult &step ) const
+{
+	// start at current node position
+	Vector pos = from;
+
+	// snap to grid
+	int cx = SnapToGrid( pos.x );
+	int cy = SnapToGrid( pos.y );
+
+	// attempt to move to adjacent node
+	switch( dir )
+	{
+		case NORTH:		cy -= navgenparams->generation_step_size; break;
+		case SOUTH:		cy += navgenparams->generation_step_size; break;
+		case EAST:		cx += navgenparams->generation_step_size; break;
+		case WEST:		cx -= navgenparams->generation_step_size; break;
+	}
+
+	pos.x = cx;
+	pos.y = cy;
+
+	// sanity check to not generate across the world for incremental generation
+	const float incrementalRange = sm_nav_generate_incremental_range.GetFloat();
+	if (m_generationMode == GENERATE_INCREMENTAL && incrementalRange > 0)
+	{
+		bool inRange = false;
+
+		for (const WalkableSeedSpot& spot : m_walkableSeeds)
+		{
+			if ((spot.pos - pos).IsLengthLessThan(incrementalRange))
+			{
+				inRange = true;
+				break;
+			}
+		}
+
+		if (!inRange)
+		{
+			return false;
+		}
+	}
+
+	if ( ( m_generationMode == GENERATE_SIMPLIFY || m_generationMode == GENERATE_REGION )
+			&& !m_simplifyGenerationExtent.Contains( pos ) )
+	{
+		return false;
+	}
+
+	// test if we can move to new position
+	trace_t result;
+	Vector to, toNormal;
+	float obstacleHeight = 0, obstacleStartDist = 0, obstacleEndDist = navgenparams->generation_step_size;
+	if ( TraceAdjacentNode( 0, from, pos, &result, navgenparams->death_drop, filter ) )
+	{
+		to = result.endpos;
+		toNormal = result.plane.normal;
+	}
+	else
+	{
+		// test going up ClimbUpHeight
+		bool success = false;
+		for ( float height = navgenparams->step_height; height <= navgenparams->climb_up_height; height += 1.0f )
+		{						
+			trace_t tr;
+			Vector start( from );
+			Vector end( pos );
+			start.z += height;
+			end.z += height;
+			trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), filter, tr);
+			if ( !tr.startsolid && tr.fraction == 1.0f )
+			{
+				if ( !StayOnFloor( &tr, navgenparams->death_drop, filter ) )
+				{
+					break;
 				}
 
+				to = tr.endpos;
+				toNormal = tr.plane.normal;
+
+				start = end = from;
+				end.z += height;
+				trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), filter, tr);
+				if ( tr.fraction < 1.0f )
+				{
+					break;
+				}
 
-				bool isOnDisplacement = result.IsDispSurface();
+				// keep track of far up we had to go to find a path to the next node
+				obstacleHeight = height;
+				success = true;
+				break;
+			}
+			else
+			{
+				// Could not trace from node to node at this height, something is in the way.
+				// Trace in the other direction to see if we hit something
+				Vector vecToObstacleStart = tr.endpos - start;
 
-				if (sm_nav_displacement_test.GetInt() > 0)
+				if ( vecToObstacleStart.LengthSqr() <= Square( navgenparams->generation_step_size ) )
 				{
-					// Test for nodes under displacement surfaces.
-					// This happens during development, and is a pain because the space underneath a displacement
-					// is not 'solid'.
-					Vector start = to + Vector(0.0f, 0.0f, 0.0f);
-					Vector end = start + Vector(0.0f, 0.0f, sm_nav_displacement_test.GetInt());
-					trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), &filter, result);
-
-					if (result.fraction > 0)
+					trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), filter, tr);
+					if ( !tr.startsolid && tr.fraction < 1.0 )
 					{
-						end = start;
-						start = result.endpos;
-						trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), &filter, result);
-						if (result.fraction < 1)
+						// We hit something going the other direction.  There is some obstacle between the two nodes.
+						Vector vecToObstacleEnd = tr.endpos - start;
+
+						if ( vecToObstacleEnd.LengthSqr() <= Square( navgenparams->generation_step_size )  )
 						{
-							// if we made it down to within StepHeight, maybe we're on a static prop
-							if (result.endpos.z > to.z + navgenparams->step_height)
+							// Remember the distances to start and end of the obstacle (with respect to the "from" node).
+							// Keep track of the last distances to obstacle as we keep increasing the height we do a trace for.
+							// If we do eventually clear the obstacle, these values will be the start and end distance to the
+							// very tip of the obstacle.
+							obstacleStartDist = vecToObstacleStart.Length();
+							obstacleEndDist = vecToObstacleEnd.Length();
+							if ( obstacleEndDist == 0 )
 							{
-								return true;
+								obstacleEndDist = navgenparams->generation_step_size;
 							}
-						}
+						}								
 					}
 				}
+			}
+		}
 
-				float deltaZ = to.z - m_currentNode->GetPosition()->z;
-				// If there's an obstacle in the way and it's traversable, or the obstacle is not higher than the destination node itself minus a small epsilon
-				// (meaning the obstacle was just the height change to get to the destination node, no extra obstacle between the two), clear obstacle height
-				// and distances
-				if ((obstacleHeight < MaxTraversableHeight) || (deltaZ > (obstacleHeight - 2.0f)))
-				{
-					obstacleHeight = 0;
-					obstacleStartDist = 0;
-					obstacleEndDist = navgenparams->generation_step_size;
-				}
+		if ( !success )
+		{
+			return false;
+		}
+	}
 
-				// we can move here
-				// create a new navigation node, and update current node pointer
-				AddNode(to, toNormal, m_generationDir, m_currentNode, isOnDisplacement, obstacleHeight, obstacleStartDist, obstacleEndDist);
+#if SOURCE_ENGINE >= SE_ORANGEBOX
+	// Don't generate nodes if we spill off the end of the world onto skybox
+	if (result.surface.flags & (SURF_SKY | SURF_SKY2D))
+	{
+		return false;
+	}
+#else
+	// Don't generate nodes if we spill off the end of the world onto skybox
+	if (result.surface.flags & (SURF_SKY))
+	{
+		return false;
+	}
+#endif // SOURCE_ENGINE >= SE_ORANGEBOX
 
-				return true;
+	// If we're incrementally generating, don't overlap existing nav areas.
+	Vector testPos( to );
+	if ( IsNodeOverlapped( testPos, Vector(  1,  1, navgenparams->human_height ), filter )
+			&& IsNodeOverlapped( testPos, Vector( -1,  1, navgenparams->human_height ), filter )
+			&& IsNodeOverlapped( testPos, Vector(  1, -1, navgenparams->human_height ), filter )
+			&& IsNodeOverlapped( testPos, Vector( -1, -1, navgenparams->human_height ), filter )
+			&& m_generationMode != GENERATE_SIMPLIFY )
+	{
+		return false;
+	}
+
+	int nTolerance = sm_nav_generate_incremental_tolerance.GetInt();
+	if ( nTolerance > 0 && m_generationMode == GENERATE_INCREMENTAL )
+	{
+		bool bValid = false;
+		int zPos = to.z;
+		for (const WalkableSeedSpot& spot : m_walkableSeeds)
+		{
+			const Vector &seedPos = spot.pos;
+			int zMin = seedPos.z - nTolerance;
+			int zMax = seedPos.z + nTolerance;
+
+			if (zPos >= zMin && zPos <= zMax)
+			{
+				bValid = true;
+				break;
 			}
 		}
 
-		// all directions have been searched from this node - pop back to its parent and continue
-		m_currentNode = m_currentNode->GetParent();
+		if (!bValid)
+			return false;
 	}
+
+
+	bool isOnDisplacement = result.IsDispSurface();
+
+	if (sm_nav_displacement_test.GetInt() > 0)
+	{
+		// Test for nodes under displacement surfaces.
+		// This happens during development, and is a pain because the space underneath a displacement
+		// is not 'solid'.
+		Vector start = to + Vector(0.0f, 0.0f, 0.0f);
+		Vector end = start + Vector(0.0f, 0.0f, sm_nav_displacement_test.GetInt());
+		trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), filter, result);
+
+		if (result.fraction > 0)
+		{
+			end = start;
+			start = result.endpos;
+			trace::hull(start, end, s_NavTraceMins, s_NavTraceMaxs, GetGenerationTraceMask(), filter, result);
+			if (result.fraction < 1)
+			{
+				// if we made it down to within StepHeight, maybe we're on a static prop
+				if (result.endpos.z > to.z + navgenparams->step_height)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	float deltaZ = to.z - from.z;
+	// If there's an obstacle in the way and it's traversable, or the obstacle is not higher than the destination node itself minus a small epsilon
+	// (meaning the obstacle was just the height change to get to the destination node, no extra obstacle between the two), clear obstacle height
+	// and distances
+	if ((obstacleHeight < MaxTraversableHeight) || (deltaZ > (obstacleHeight - 2.0f)))
+	{
+		obstacleHeight = 0;
+		obstacleStartDist = 0;
+		obstacleEndDist = navgenparams->generation_step_size;
+	}
+
+	step.to = to;
+	step.normal = toNormal;
+	step.obstacleHeight = obstacleHeight;
+	step.obstacleStartDist = obstacleStartDist;
+	step.obstacleEndDist = obstacleEndDist;
+	step.isOnDisplacement = isOnDisplacement;
+	return true;
 }
 
 bool CNavMesh::AddWalkableSeed(const Vector& pos)
@@ -4654,10 +4944,11 @@ CON_COMMAND_F(sm_nav_subdivide, "Subdivides all selected areas.", FCVAR_GAMEDLL
 /**
 * Debugging code to verify that all nav area connections are internally consistent
 */
-void CNavMesh::ValidateNavAreaConnections( void )
+int CNavMesh::ValidateNavAreaConnections( void )
 {
 	// iterate all nav areas
 	NavConnect connect;
+	int errors = 0;
 
 	for ( int it = 0; it < TheNavAreas.Count(); it++ )
 	{
@@ -4676,6 +4967,7 @@ void CNavMesh::ValidateNavAreaConnections( void )
 				if ( pIncoming->Find( connect ) != pIncoming->InvalidIndex() )
 				{
 					Msg( "Area %d has area %d on both 2-way and incoming list, should only be on one\n", area->GetID(), areaOther->GetID() );
+					++errors;
 					Assert( false );
 				}
 
@@ -4685,6 +4977,7 @@ void CNavMesh::ValidateNavAreaConnections( void )
 					if ( areaOther == (*pOutgoing)[iConnectCheck].area )
 					{
 						Msg( "Area %d has multiple outgoing connections to area %d in direction %d\n", area->GetID(), areaOther->GetID(), dir );
+						++errors;
 						Assert( false );
 					}
 				}
@@ -4701,6 +4994,7 @@ void CNavMesh::ValidateNavAreaConnections( void )
 					if ( !bOnOthersIncomingList )
 					{
 						Msg( "Area %d has one-way connect to area %d but does not appear on the latter's incoming list\n", area->GetID(), areaOther->GetID() );
+						++errors;
 					}					
 				}
 			}
@@ -4716,6 +5010,7 @@ void CNavMesh::ValidateNavAreaConnections( void )
 					if ( areaOther == areaCheck )
 					{
 						Msg( "Area %d has multiple incoming connections to area %d in direction %d\n", area->GetID(), areaOther->GetID(), dir );
+						++errors;
 						Assert( false );
 					}
 				}
@@ -4726,11 +5021,14 @@ void CNavMesh::ValidateNavAreaConnections( void )
 				if ( !bOnOthersOutgoingList )
 				{
 					Msg( "Area %d has incoming connection from area %d but does not appear on latter's outgoing connection list\n", area->GetID(), areaOther->GetID() );
+					++errors;
 					Assert( false );
 				}
 			}
 		}
 	}
+
+	return errors;
 }
 
 void CNavMesh::CycleChangeGenerationTraceMask(unsigned int mask)
@@ -20,6 +20,7 @@
 
 #include "nav.h"
 #include <sdkports/sdk_ehandle.h>
+#include <util/memory_tracker.h>
 
 class CUtlBuffer;
 class CNavMesh;
@@ -75,7 +76,7 @@ struct LadderToAreaConnection
  * The NavLadder represents ladders in the Navigation Mesh, and their connections to adjacent NavAreas
  * @todo Deal with ladders that allow jumping off to areas in the middle
  */
-class CNavLadder
+class CNavLadder : public memtracker::CTrackedObject<memtracker::Category::NAV_LADDERS>
 {
 public:
 	CNavLadder( void ) :
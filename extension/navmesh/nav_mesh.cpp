@@ -43,6 +43,7 @@
 #include <utlhash.h>
 #include <generichash.h>
 #include <fmtstr.h>
+#include <util/hotpath_profiler.h>
 
 #ifdef EXT_VPROF_ENABLED
 #include <tier0/vprof.h>
@@ -68,6 +69,8 @@ ConVar sm_nav_show_func_nav_prefer("sm_nav_show_func_nav_prefer", "0", FCVAR_GAM
 ConVar sm_nav_show_func_nav_prerequisite("sm_nav_show_func_nav_prerequisite", "0", FCVAR_GAMEDLL | FCVAR_CHEAT, "Show areas of designer-placed bot preference due to func_nav_prerequisite entities");
 ConVar sm_nav_max_vis_delta_list_length("sm_nav_max_vis_delta_list_length", "64", FCVAR_CHEAT);
 #endif // NAVMESH_REMOVED_FEATURES
+static ConVar sm_nav_area_update_quota("sm_nav_area_update_quota", "64", FCVAR_GAMEDLL, "Maximum number of active nav areas receiving their periodic update per frame.", true, 1.0f, false, 0.0f);
+static ConVar sm_nav_grid_cell_size("sm_nav_grid_cell_size", "0", FCVAR_GAMEDLL, "Size of the nav mesh spatial grid cells. If zero, the size is computed from the density of the nav areas. Applied when the nav mesh is loaded.", true, 0.0f, true, 2048.0f);
 ConVar sm_nav_solid_func_brush("sm_nav_solid_func_brush", "0", FCVAR_GAMEDLL | FCVAR_CHEAT, "If enabled, func_brush entities are always considered solid for nav mesh generation/editing.");
 
 
@@ -133,10 +136,15 @@ template bool ForEachActor(ForgetArea&);
 CNavMesh::CNavMesh( void )
 {
 	m_gridCellSize = 300.0f;
+	m_gridSizeX = 0;
+	m_gridSizeY = 0;
+	m_gridBlockSizeX = 0;
+	m_gridBlockSizeY = 0;
 	m_editMode = NORMAL;
 	m_bQuitWhenFinished = false;
 	m_noAutoBreakables = false;
 	m_hostThreadModeRestoreValue = 0;
+	m_connectivityEpoch = 0U;
 	// m_placeCount = 0;
 	// m_placeName = NULL;
 	RestartUpdateTimers();
@@ -154,6 +162,7 @@ CNavMesh::CNavMesh( void )
 	m_selectedPrerequisite = nullptr;
 	m_lastLoadResult = NavErrorType::MAX_NAV_ERROR_TYPES;
 	m_generationTraceMask = MASK_PLAYERSOLID_BRUSHONLY;
+	m_activeAreaCursor = 0U;
 		
 	Reset();
 
@@ -493,8 +502,14 @@ void CNavMesh::DestroyNavigationMesh( bool incremental )
 	}
 
 	m_blockedAreas.RemoveAll();
+	m_reachability.Invalidate();
+	m_pathCache.Clear();
+	m_dangerMap.Clear();
+	BumpConnectivityEpoch();
 	m_avoidanceObstacleAreas.clear();
 	m_transientAreas.clear();
+	m_activeAreas.clear();
+	m_activeAreaCursor = 0U;
 	m_recomputeDataReason = RecomputeInternalDataReason::RECOMPUTEREASON_RESET;
 	m_recomputeInternalDataTimer.Invalidate();
 
@@ -544,8 +559,12 @@ void CNavMesh::DestroyNavigationMesh( bool incremental )
 	{
 		// destroy the grid
 		m_grid.RemoveAll();
+		m_gridBounds.RemoveAll();
+		m_gridBlockBounds.RemoveAll();
 		m_gridSizeX = 0;
 		m_gridSizeY = 0;
+		m_gridBlockSizeX = 0;
+		m_gridBlockSizeY = 0;
 	}
 
 	// clear the hash table
@@ -589,6 +608,8 @@ void CNavMesh::Update( void )
 	VPROF_BUDGET("[NavBot] CNavMesh::Update", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
+	NAVBOT_PROFILE_SCOPE("CNavMesh::Update");
+
 	if (IsGenerating())
 	{
 		UpdateGeneration( 0.03f );
@@ -607,6 +628,14 @@ void CNavMesh::Update( void )
 	UpdateAvoidanceObstacleAreas();
 	UpdateNavBlockers();
 	UpdateNavPathCostModifiers();
+	m_dangerMap.Update();
+	m_reachability.Update(m_isEditing);
+
+	if (m_isEditing)
+	{
+		// edits don't go through the area connection functions
+		BumpConnectivityEpoch();
+	}
 
 	if (m_recomputeInternalDataTimer.HasStarted() && m_recomputeInternalDataTimer.IsElapsed())
 	{
@@ -675,24 +704,7 @@ void CNavMesh::Update( void )
 	}
 #endif // NAVMESH_REMOVED_FEATURES
 
-	{
-		FOR_EACH_VEC(TheNavAreas, it)
-		{
-			CNavArea* area = TheNavAreas[it];
-
-			area->OnFrame();
-
-			if (m_invokeAreaUpdateTimer.IsElapsed())
-			{
-				area->OnUpdate();
-			}
-		}
-
-		if (m_invokeAreaUpdateTimer.IsElapsed())
-		{
-			m_invokeAreaUpdateTimer.Start(NAV_AREA_UPDATE_INTERVAL);
-		}
-	}
+	UpdateActiveAreas();
 
 	if (m_invokeWaypointUpdateTimer.IsElapsed())
 	{
@@ -824,6 +836,93 @@ int CNavMesh::GetEventDebugID(void)
 #endif // SOURCE_ENGINE >= SE_LEFT4DEAD
 
 
+//--------------------------------------------------------------------------------------------------------------
+// Grid bounds helpers, empty bounds are inverted so every distance to them is huge
+static inline void ClearGridBounds( Extent &bounds )
+{
+	bounds.lo.Init( FLT_MAX, FLT_MAX, FLT_MAX );
+	bounds.hi.Init( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+}
+
+static inline void AddToGridBounds( Extent &bounds, const Extent &extent )
+{
+	for ( int i = 0; i < 3; ++i )
+	{
+		bounds.lo[i] = MIN( bounds.lo[i], extent.lo[i] );
+		bounds.hi[i] = MAX( bounds.hi[i], extent.hi[i] );
+	}
+}
+
+// lower bound of the squared distance between the given position and anything inside the bounds
+static inline float DistanceSqrToGridBounds( const Vector &pos, const Extent &bounds )
+{
+	if ( bounds.lo.x > bounds.hi.x )
+	{
+		return FLT_MAX;
+	}
+
+	float distSq = 0.0f;
+
+	for ( int i = 0; i < 3; ++i )
+	{
+		float delta = 0.0f;
+
+		if ( pos[i] < bounds.lo[i] )
+		{
+			delta = bounds.lo[i] - pos[i];
+		}
+		else if ( pos[i] > bounds.hi[i] )
+		{
+			delta = pos[i] - bounds.hi[i];
+		}
+
+		distSq += delta * delta;
+	}
+
+	return distSq;
+}
+
+//--------------------------------------------------------------------------------------------------------------
+/**
+ * Returns the grid cell size for the current set of areas.
+ * The cell size follows the median area size, so the dense parts of the map don't end up with dozens of areas per cell.
+ */
+float CNavMesh::ComputeGridCellSize( float minX, float maxX, float minY, float maxY ) const
+{
+	constexpr float DEFAULT_CELL_SIZE = 300.0f;
+	constexpr float MIN_CELL_SIZE = 150.0f;
+	constexpr float MAX_CELL_SIZE = 600.0f;
+	constexpr float AREAS_PER_CELL = 16.0f;
+	constexpr float MAX_CELLS = 1024.0f * 1024.0f;
+
+	if ( sm_nav_grid_cell_size.GetFloat() > 0.0f )
+	{
+		return sm_nav_grid_cell_size.GetFloat();
+	}
+
+	if ( TheNavAreas.Count() == 0 )
+	{
+		return DEFAULT_CELL_SIZE;
+	}
+
+	std::vector<float> sizes;
+	sizes.reserve( TheNavAreas.Count() );
+
+	FOR_EACH_VEC( TheNavAreas, it )
+	{
+		sizes.push_back( TheNavAreas[it]->GetSizeX() * TheNavAreas[it]->GetSizeY() );
+	}
+
+	auto median = sizes.begin() + sizes.size() / 2;
+	std::nth_element( sizes.begin(), median, sizes.end() );
+
+	float cellSize = clamp( sqrtf( *median * AREAS_PER_CELL ), MIN_CELL_SIZE, MAX_CELL_SIZE );
+
+	// don't let huge maps allocate a huge grid
+	const float minCellSize = sqrtf( ( ( maxX - minX ) * ( maxY - minY ) ) / MAX_CELLS );
+	return MAX( cellSize, minCellSize );
+}
+
 //--------------------------------------------------------------------------------------------------------------
 /**
  * Allocate the grid and define its extents
@@ -831,14 +930,34 @@ int CNavMesh::GetEventDebugID(void)
 void CNavMesh::AllocateGrid( float minX, float maxX, float minY, float maxY )
 {
 	m_grid.RemoveAll();
+	m_gridBounds.RemoveAll();
+	m_gridBlockBounds.RemoveAll();
 
 	m_minX = minX;
 	m_minY = minY;
 
+	m_gridCellSize = ComputeGridCellSize( minX, maxX, minY, maxY );
+
 	m_gridSizeX = (int)((maxX - minX) / m_gridCellSize) + 1;
 	m_gridSizeY = (int)((maxY - minY) / m_gridCellSize) + 1;
 
 	m_grid.SetCount( m_gridSizeX * m_gridSizeY );
+	m_gridBounds.SetCount( m_gridSizeX * m_gridSizeY );
+
+	m_gridBlockSizeX = ( m_gridSizeX + GRID_BLOCK_SIZE - 1 ) / GRID_BLOCK_SIZE;
+	m_gridBlockSizeY = ( m_gridSizeY + GRID_BLOCK_SIZE - 1 ) / GRID_BLOCK_SIZE;
+
+	m_gridBlockBounds.SetCount( m_gridBlockSizeX * m_gridBlockSizeY );
+
+	FOR_EACH_VEC( m_gridBounds, it )
+	{
+		ClearGridBounds( m_gridBounds[it] );
+	}
+
+	FOR_EACH_VEC( m_gridBlockBounds, it )
+	{
+		ClearGridBounds( m_gridBlockBounds[it] );
+	}
 }
 
 //--------------------------------------------------------------------------------------------------------------
@@ -859,11 +978,16 @@ void CNavMesh::AddNavArea( CNavArea *area )
 	int hiX = WorldToGridX( area->GetCorner( SOUTH_EAST ).x );
 	int hiY = WorldToGridY( area->GetCorner( SOUTH_EAST ).y );
 
+	Extent areaExtent;
+	area->GetExtent( &areaExtent );
+
 	for( int y = loY; y <= hiY; ++y )
 	{
 		for( int x = loX; x <= hiX; ++x )
 		{
 			m_grid[ x + y*m_gridSizeX ].AddToTail( const_cast<CNavArea *>( area ) );
+			AddToGridBounds( m_gridBounds[ x + y*m_gridSizeX ], areaExtent );
+			AddToGridBounds( m_gridBlockBounds[ ( x / GRID_BLOCK_SIZE ) + ( y / GRID_BLOCK_SIZE ) * m_gridBlockSizeX ], areaExtent );
 		}
 	}
 
@@ -891,6 +1015,11 @@ void CNavMesh::AddNavArea( CNavArea *area )
 		m_transientAreas.push_back(area);
 	}
 
+	if (area->WantsUpdate())
+	{
+		AddActiveArea(area);
+	}
+
 	++m_areaCount;
 }
 
@@ -911,6 +1040,7 @@ void CNavMesh::RemoveNavArea( CNavArea *area )
 		for( int x = loX; x <= hiX; ++x )
 		{
 			m_grid[ x + y*m_gridSizeX ].FindAndRemove( area );
+			// the cell and block bounds are left as they are, they are still a valid lower bound for searches
 		}
 	}
 
@@ -944,6 +1074,7 @@ void CNavMesh::RemoveNavArea( CNavArea *area )
 
 	OnAvoidanceObstacleLeftArea(area);
 	m_blockedAreas.FindAndRemove( area );
+	RemoveActiveArea(area);
 
 	--m_areaCount;
 }
@@ -961,6 +1092,7 @@ void CNavMesh::OnServerActivate( void )
 		area->OnServerActivate();
 	}
 
+	m_dangerMap.Clear();
 	BuildTransientAreaList();
 
 	// Some mods may not have round start events, call this at least once on every new map load
@@ -1026,6 +1158,8 @@ void CNavMesh::OnRoundRestart( void )
 
 	RestartUpdateTimers();
 	RemoveAllEntitiesFromForcedSolidList(); // entities are deleted and re-created between rounds, clear the list
+	m_dangerMap.Clear();
+	BuildActiveAreaList();
 	ScheduleRecomputationOfInternalData(CNavMesh::RecomputeInternalDataReason::RECOMPUTEREASON_RESET);
 	OnRoundRestart_AvoidanceObstacles();
 
@@ -1113,6 +1247,83 @@ void CNavMesh::BuildTransientAreaList( void )
 	}
 }
 
+//--------------------------------------------------------------------------------------------------------------
+void CNavMesh::BuildActiveAreaList()
+{
+	m_activeAreas.clear();
+	m_activeAreaCursor = 0U;
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+
+		if (area->WantsUpdate())
+		{
+			m_activeAreas.push_back(area);
+		}
+	}
+}
+
+void CNavMesh::AddActiveArea(CNavArea* area)
+{
+	if (std::find(m_activeAreas.begin(), m_activeAreas.end(), area) == m_activeAreas.end())
+	{
+		m_activeAreas.push_back(area);
+	}
+}
+
+void CNavMesh::RemoveActiveArea(CNavArea* area)
+{
+	auto it = std::find(m_activeAreas.begin(), m_activeAreas.end(), area);
+
+	if (it == m_activeAreas.end())
+	{
+		return;
+	}
+
+	const std::size_t index = static_cast<std::size_t>(std::distance(m_activeAreas.begin(), it));
+	m_activeAreas.erase(it);
+
+	// keep the cursor on the same area
+	if (index < m_activeAreaCursor)
+	{
+		m_activeAreaCursor--;
+	}
+}
+
+void CNavMesh::UpdateActiveAreas()
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CNavMesh::UpdateActiveAreas", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	// index loops, areas may add or remove themselves from the list
+	for (std::size_t i = 0U; i < m_activeAreas.size(); i++)
+	{
+		m_activeAreas[i]->OnFrame();
+	}
+
+	if (m_activeAreaCursor >= m_activeAreas.size())
+	{
+		// the last pass is done, start a new one every update interval
+		if (!m_invokeAreaUpdateTimer.IsElapsed())
+		{
+			return;
+		}
+
+		m_invokeAreaUpdateTimer.Start(NAV_AREA_UPDATE_INTERVAL);
+		m_activeAreaCursor = 0U;
+	}
+
+	// spread the pass over multiple frames
+	const std::size_t quota = static_cast<std::size_t>(sm_nav_area_update_quota.GetInt());
+
+	for (std::size_t i = 0U; i < quota && m_activeAreaCursor < m_activeAreas.size(); i++)
+	{
+		m_activeAreas[m_activeAreaCursor++]->OnUpdate();
+	}
+}
+
 void CNavMesh::UpdateAvoidanceObstacles(void)
 {
 #ifdef EXT_VPROF_ENABLED
@@ -1353,108 +1564,131 @@ CNavArea *CNavMesh::GetNearestNavArea( const Vector &pos, float maxDist, bool ch
 	}
 
 
-	// get list in cell that contains position
-	int originX = WorldToGridX( pos.x );
-	int originY = WorldToGridY( pos.y );
-
-	int shiftLimit = ceil(maxDist / m_gridCellSize);
+	// get the block that contains the position
+	const int originX = WorldToGridX( pos.x ) / GRID_BLOCK_SIZE;
+	const int originY = WorldToGridY( pos.y ) / GRID_BLOCK_SIZE;
+	const float blockSize = m_gridCellSize * GRID_BLOCK_SIZE;
+	const int shiftLimit = MAX( MAX( originX, m_gridBlockSizeX - 1 - originX ), MAX( originY, m_gridBlockSizeY - 1 - originY ) );
 
 	//
-	// Search in increasing rings out from origin, starting with cell
+	// Search in increasing rings of blocks out from origin, starting with the block
 	// that contains the given position.
-	// Once we find a close area, we must check one more step out in
-	// case our position is just against the edge of the cell boundary
-	// and an area in an adjacent cell is actually closer.
+	// Blocks and cells are skipped when the bounds of their areas are further away
+	// than the closest area found so far, the search stops once a whole ring is.
 	// 
 	for( int shift=0; shift <= shiftLimit; ++shift )
 	{
-		for( int x = originX - shift; x <= originX + shift; ++x )
+		if ( shift > 0 )
+		{
+			// distance from the position to the edge of the blocks already searched
+			float ringDist = pos.x - ( m_minX + ( originX - shift + 1 ) * blockSize );
+			ringDist = MIN( ringDist, m_minX + ( originX + shift ) * blockSize - pos.x );
+			ringDist = MIN( ringDist, pos.y - ( m_minY + ( originY - shift + 1 ) * blockSize ) );
+			ringDist = MIN( ringDist, m_minY + ( originY + shift ) * blockSize - pos.y );
+
+			if ( ringDist > 0.0f && ringDist * ringDist >= closeDistSq )
+				break;
+		}
+
+		for( int bx = originX - shift; bx <= originX + shift; ++bx )
 		{
-			if ( x < 0 || x >= m_gridSizeX )
+			if ( bx < 0 || bx >= m_gridBlockSizeX )
 				continue;
 
-			for( int y = originY - shift; y <= originY + shift; ++y )
+			for( int by = originY - shift; by <= originY + shift; ++by )
 			{
-				if ( y < 0 || y >= m_gridSizeY
+				if ( by < 0 || by >= m_gridBlockSizeY
 
-				// only check these areas if we're on the outer edge of our spiral
-						|| (x > originX - shift &&
-					 x < originX + shift &&
-					 y > originY - shift &&
-					 y < originY + shift) )
+				// only check these blocks if we're on the outer edge of our spiral
+						|| (bx > originX - shift &&
+					 bx < originX + shift &&
+					 by > originY - shift &&
+					 by < originY + shift) )
 					continue;
 
-				NavAreaVector *areaVector = &m_grid[ x + y*m_gridSizeX ];
+				if ( DistanceSqrToGridBounds( pos, m_gridBlockBounds[ bx + by*m_gridBlockSizeX ] ) >= closeDistSq )
+					continue;
 
-				// find closest area in this cell
-				FOR_EACH_VEC( (*areaVector), it )
+				const int endX = MIN( ( bx + 1 ) * GRID_BLOCK_SIZE, m_gridSizeX );
+				const int endY = MIN( ( by + 1 ) * GRID_BLOCK_SIZE, m_gridSizeY );
+
+				for( int y = by * GRID_BLOCK_SIZE; y < endY; ++y )
 				{
-					CNavArea *area = (*areaVector)[ it ];
-
-					// skip if we've already visited this area
-					if ( area->m_nearNavSearchMarker == searchMarker
-							// don't consider blocked areas
-							|| area->IsBlocked( team )
-							// don't consider area that is overhead
-							|| area->GetCenter().z - pos.z > navgenparams->human_height)
-						continue;
-
-					// mark as visited
-					area->m_nearNavSearchMarker = searchMarker;
-
-					Vector areaPos;
-					area->GetClosestPointOnArea( source, &areaPos );
-
-					// TERROR: Using the original pos for distance calculations.  Since it's a pure 3D distance,
-					// with no Z restrictions or LOS checks, this should work for passing in bot foot positions.
-					// This needs to be ported back to CS:S.
-					float distSq = ( areaPos - pos ).LengthSqr();
-
-					// keep the closest area
-					if ( distSq >= closeDistSq )
-						continue;
-
-					// check LOS to area
-					// REMOVED: If we do this for !anyZ, it's likely we wont have LOS and will enumerate every area in the mesh
-					// It is still good to do this in some isolated cases, however
-					if ( checkLOS )
+					for( int x = bx * GRID_BLOCK_SIZE; x < endX; ++x )
 					{
-						trace_t result;
-
-						// make sure 'pos' is not embedded in the world
-						trace::line(pos, pos + Vector(0, 0, navgenparams->step_height), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
+						if ( DistanceSqrToGridBounds( pos, m_gridBounds[ x + y*m_gridSizeX ] ) >= closeDistSq )
+							continue;
 
-						// it was embedded - move it out
-						Vector safePos = result.startsolid ? result.endpos + Vector( 0, 0, 1.0f )
-									: pos;
+						NavAreaVector *areaVector = &m_grid[ x + y*m_gridSizeX ];
 
-						// Don't bother tracing from the nav area up to safePos.z if it's within navgenparams->step_height of the area, since areas can be embedded in the ground a bit
-						float heightDelta = fabs(areaPos.z - safePos.z);
-						if ( heightDelta > navgenparams->step_height )
+						// find closest area in this cell
+						FOR_EACH_VEC( (*areaVector), it )
 						{
-							// trace to the height of the original point
-							trace::line(areaPos + Vector(0, 0, navgenparams->step_height), Vector(areaPos.x, areaPos.y, safePos.z), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
-							
-							if ( result.fraction != 1.0f )
-							{
+							CNavArea *area = (*areaVector)[ it ];
+
+							// skip if we've already visited this area
+							if ( area->m_nearNavSearchMarker == searchMarker
+									// don't consider blocked areas
+									|| area->IsBlocked( team )
+									// don't consider area that is overhead
+									|| area->GetCenter().z - pos.z > navgenparams->human_height)
 								continue;
-							}
-						}
 
-						// trace to the original point's height above the area
-						trace::line(safePos, Vector(areaPos.x, areaPos.y, safePos.z + navgenparams->step_height), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
+							// mark as visited
+							area->m_nearNavSearchMarker = searchMarker;
 
-						if ( result.fraction != 1.0f )
-						{
-							continue;
-						}
-					}
+							Vector areaPos;
+							area->GetClosestPointOnArea( source, &areaPos );
+
+							// TERROR: Using the original pos for distance calculations.  Since it's a pure 3D distance,
+							// with no Z restrictions or LOS checks, this should work for passing in bot foot positions.
+							// This needs to be ported back to CS:S.
+							float distSq = ( areaPos - pos ).LengthSqr();
+
+							// keep the closest area
+							if ( distSq >= closeDistSq )
+								continue;
+
+							// check LOS to area
+							// REMOVED: If we do this for !anyZ, it's likely we wont have LOS and will enumerate every area in the mesh
+							// It is still good to do this in some isolated cases, however
+							if ( checkLOS )
+							{
+								trace_t result;
+
+								// make sure 'pos' is not embedded in the world
+								trace::line(pos, pos + Vector(0, 0, navgenparams->step_height), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
+
+								// it was embedded - move it out
+								Vector safePos = result.startsolid ? result.endpos + Vector( 0, 0, 1.0f )
+											: pos;
 
-					closeDistSq = distSq;
-					close = area;
+								// Don't bother tracing from the nav area up to safePos.z if it's within navgenparams->step_height of the area, since areas can be embedded in the ground a bit
+								float heightDelta = fabs(areaPos.z - safePos.z);
+								if ( heightDelta > navgenparams->step_height )
+								{
+									// trace to the height of the original point
+									trace::line(areaPos + Vector(0, 0, navgenparams->step_height), Vector(areaPos.x, areaPos.y, safePos.z), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
+							
+									if ( result.fraction != 1.0f )
+									{
+										continue;
+									}
+								}
+
+								// trace to the original point's height above the area
+								trace::line(safePos, Vector(areaPos.x, areaPos.y, safePos.z + navgenparams->step_height), MASK_PLAYERSOLID_BRUSHONLY, nullptr, COLLISION_GROUP_NONE, result);
+
+								if ( result.fraction != 1.0f )
+								{
+									continue;
+								}
+							}
 
-					// look one more step outwards
-					shiftLimit = shift+1;
+							closeDistSq = distSq;
+							close = area;
+						}
+					}
 				}
 			}
 		}
@@ -2101,73 +2335,6 @@ void CNavMesh::DrawFuncNavPrerequisite( void ) const
 #endif
 
 
-//--------------------------------------------------------------------------------------------------------------
-/**
- * Increase the danger of nav areas containing and near the given position
- */
-void CNavMesh::IncreaseDangerNearby( int teamID, float amount, CNavArea *startArea, const Vector &pos, float maxRadius, float dangerLimit )
-{
-	if (startArea == NULL)
-		return;
-
-	CNavArea::MakeNewMarker();
-	CNavArea::ClearSearchLists();
-
-	startArea->AddToOpenList();
-	startArea->SetTotalCost( 0.0f );
-	startArea->Mark();
-
-	float finalDanger = amount;
-
-	if ( dangerLimit > 0.0f && startArea->GetDanger( teamID ) + finalDanger > dangerLimit )
-	{
-		// clamp danger to given limit
-		finalDanger = dangerLimit - startArea->GetDanger( teamID );
-	}
-
-	startArea->IncreaseDanger( teamID, finalDanger );
-
-	
-	while( !CNavArea::IsOpenListEmpty() )
-	{
-		// get next area to check
-		CNavArea *area = CNavArea::PopOpenList();
-		
-		// explore adjacent areas
-		for( int dir=0; dir<NUM_DIRECTIONS; ++dir )
-		{
-			int count = area->GetAdjacentCount( (NavDirType)dir );
-			for( int i=0; i<count; ++i )
-			{
-				CNavArea *adjArea = area->GetAdjacentArea( (NavDirType)dir, i );
-
-				if (!adjArea->IsMarked())
-				{
-					// compute distance from danger source
-					float cost = (adjArea->GetCenter() - pos).Length();
-					if (cost <= maxRadius)
-					{
-						adjArea->AddToOpenList();
-						adjArea->SetTotalCost( cost );
-						adjArea->Mark();
-
-						finalDanger = amount * cost/maxRadius;
-
-						if ( dangerLimit > 0.0f && adjArea->GetDanger( teamID ) + finalDanger > dangerLimit )
-						{
-							// clamp danger to given limit
-							finalDanger = dangerLimit - adjArea->GetDanger( teamID );
-						}
-
-						adjArea->IncreaseDanger( teamID, finalDanger );
-					}
-				}
-			}
-		}
-	}
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 static void CommandNavRemoveJumpAreas( void )
 {
@@ -3829,6 +3996,9 @@ void CNavMesh::OnAreaBlocked( CNavArea *area )
 	{
 		m_blockedAreas.AddToTail( area );
 	}
+
+	m_reachability.MarkDirty();
+	BumpConnectivityEpoch();
 }
 
 
@@ -3837,6 +4007,8 @@ void CNavMesh::OnAreaBlocked( CNavArea *area )
 void CNavMesh::OnAreaUnblocked( CNavArea *area )
 {
 	m_blockedAreas.FindAndRemove( area );
+	m_reachability.MarkDirty();
+	BumpConnectivityEpoch();
 }
 
 
@@ -3863,10 +4035,35 @@ void CNavMesh::UpdateNavBlockers()
 			return !blocker->IsValid();
 		}), m_navblockers.end());
 
-		std::for_each(m_navblockers.begin(), m_navblockers.end(), [](std::unique_ptr<INavBlocker>& blocker) {
+		// blocked status for every team, bit 0 is NAV_TEAM_ANY
+		auto getBlockedBits = [](const INavBlocker* blocker) {
+			std::uint32_t bits = blocker->IsBlocked(NAV_TEAM_ANY) ? 1U : 0U;
+
+			for (unsigned int team = 0U; team < NAV_TEAMS_ARRAY_SIZE; team++)
+			{
+				if (blocker->IsBlocked(static_cast<int>(team)))
+				{
+					bits |= 2U << team;
+				}
+			}
+
+			return bits;
+		};
+
+		bool changed = false;
+
+		std::for_each(m_navblockers.begin(), m_navblockers.end(), [&changed, &getBlockedBits](std::unique_ptr<INavBlocker>& blocker) {
+			const std::uint32_t before = getBlockedBits(blocker.get());
 			blocker->Update();
+			changed = changed || before != getBlockedBits(blocker.get());
 		});
 
+		if (changed)
+		{
+			m_reachability.MarkDirty();
+			BumpConnectivityEpoch();
+		}
+
 		m_updateNavBlockersTimer.Start(NAV_BLOCKERS_UPDATE_INTERVAL);
 	}
 }
@@ -4090,7 +4287,7 @@ void CNavMesh::ComputePhysPropsAvoidanceObstacles()
 
 std::shared_ptr<CWaypoint> CNavMesh::CreateWaypoint() const
 {
-	return std::make_shared<CWaypoint>();
+	return std::allocate_shared<CWaypoint>(memtracker::TrackedAllocator<CWaypoint, memtracker::Category::WAYPOINTS>());
 }
 
 std::shared_ptr<CNavVolume> CNavMesh::CreateVolume() const
@@ -4773,6 +4970,8 @@ void CNavMesh::RegisterNavBlocker(INavBlocker* blocker)
 {
 	m_navblockers.emplace_back(blocker);
 	blocker->PostRegister();
+	m_reachability.MarkDirty();
+	BumpConnectivityEpoch();
 }
 
 void CNavMesh::UnregisterNavBlocker(INavBlocker* blocker)
@@ -4783,6 +4982,9 @@ void CNavMesh::UnregisterNavBlocker(INavBlocker* blocker)
 	m_navblockers.erase(std::remove_if(m_navblockers.begin(), m_navblockers.end(), [&blocker](const std::unique_ptr<INavBlocker>& obj) {
 		return obj.get() == blocker;
 	}), m_navblockers.end());
+
+	m_reachability.MarkDirty();
+	BumpConnectivityEpoch();
 }
 
 void CNavMesh::DestroyAllNavBlockers()
@@ -4818,6 +5020,9 @@ void CNavMesh::ComputeInternalData()
 		blocker->OnRecomputeInternalData();
 	});
 
+	m_reachability.MarkDirty();
+	BumpConnectivityEpoch();
+
 	OnRecomputeInternalData_AvoidanceObstacles();
 	ComputeDoorBlockers();
 	ComputeBreakableBlockers();
@@ -44,6 +44,9 @@
 #include "nav_colors.h"
 #include "nav_avoidance_obstacle.h"
 #include "nav_settings.h"
+#include "nav_reachability.h"
+#include "nav_path_cache.h"
+#include "nav_danger_map.h"
 
 class HidingSpot;
 class CUtlBuffer;
@@ -57,6 +60,7 @@ class CFuncBreakableNavBlocker;
 class CFuncBrushNavBlocker;
 class CBaseBot;
 class CBaseExtPlayer;
+class ITraceFilter;
 
 namespace SourceMod
 {
@@ -331,7 +335,7 @@ public:
 	CNavMesh(void);
 	virtual ~CNavMesh();
 
-	static constexpr uint32_t NavMeshVersion = 1;
+	static constexpr uint32_t NavMeshVersion = 2; // 2: area static attributes
 	static constexpr uint32_t NavMagicNumber = 0x20110FC0;
 	static bool IsEditing();
 	static void SetupGenerationHullSize();
@@ -594,8 +598,6 @@ public:
 	bool GetSimpleGroundHeight( const Vector &pos, float *height, Vector *normal = nullptr ) const;// get the Z coordinate of the ground level directly below the given point
 
 
-	/// increase "danger" weights in the given nav area and nearby ones
-	void IncreaseDangerNearby( int teamID, float amount, CNavArea *area, const Vector &pos, float maxRadius, float dangerLimit = -1.0f );
 	void DrawDanger( void ) const;										// draw the current danger levels
 	void DrawPlayerCounts( void ) const;								// draw the current player counts for each area
 	void DrawFuncNavAvoid( void ) const;								// draw bot avoidance areas from func_nav_avoid entities
@@ -727,6 +729,8 @@ public:
 	void CommandNavReloadMesh();										// Saves the navigation mesh and reloads it
 	void CommandNavMeasureDistance();									// Measures the distance between two nav areas
 	void CommandNavDumpToKeyValues();									// Dumps nav mesh data to a KV file
+	void CommandNavValidate();											// Checks the nav mesh connections for errors
+	void CommandNavStats() const;										// Prints nav mesh statistics
 	void CommandNavDebugAutoBlockers();									// Debug automatic nav blockers
 
 	void AddToDragSelectionSet( CNavArea *pArea );
@@ -1406,6 +1410,10 @@ public:
 	CNavLadder *GetLadderByID( unsigned int id ) const;
 
 	const std::vector<CNavArea*>& GetTransientAreas() const { return m_transientAreas; }
+	// Adds an area to the active area list. Active areas receive OnFrame calls every frame and OnUpdate calls at intervals.
+	void AddActiveArea(CNavArea* area);
+	void RemoveActiveArea(CNavArea* area);
+	const std::vector<CNavArea*>& GetActiveAreas() const { return m_activeAreas; }
 
 	enum EditModeType
 	{
@@ -1422,6 +1430,7 @@ public:
 	bool IsEditMode( EditModeType mode ) const;					// return true if current mode matches given mode
 	bool FindNavAreaOrLadderAlongRay( const Vector &start, const Vector &end, CNavArea **area, CNavLadder **ladder, CNavArea *ignore = nullptr ) const;
 	void SimplifySelectedAreas( void );	// Simplifies the selected set by reducing to 1x1 areas and re-merging them up with loosened tolerances
+	void RegenerateRegion( const Extent &bounds );	// Destroys the areas overlapping the given bounds and generates new ones in their place
 	/**
 	 * @brief Gets the full path to the nav mesh file.
 	 * @param isLoad True if we are loading a file, false if saving.
@@ -1483,6 +1492,21 @@ public:
 	}
 
 	bool IsInternalDataRecomputationScheduled() const { return m_recomputeInternalDataTimer.HasStarted(); }
+	// Connected component labels and incoming connections of the nav areas
+	CNavReachability& GetReachability() { return m_reachability; }
+	// Called when nav area connections are added or removed
+	void OnAreaConnectionsChanged()
+	{
+		m_reachability.Invalidate();
+		BumpConnectivityEpoch();
+	}
+	// Cache of recently computed area sequences
+	CNavPathCache& GetPathCache() { return m_pathCache; }
+	// Per team nav area danger
+	CNavDangerMap& GetDangerMap() { return m_dangerMap; }
+	// Incremented every time the nav mesh connectivity or the blocked status of an area changes.
+	unsigned int GetConnectivityEpoch() const { return m_connectivityEpoch; }
+	void BumpConnectivityEpoch() { m_connectivityEpoch++; }
 	RecomputeInternalDataReason GetRecomputeInternalDataReason() const { return m_recomputeDataReason; }
 	NavCornerType GetMarkedCorner() const { return m_markedCorner; }
 
@@ -1531,6 +1555,12 @@ private:
 	float m_minY;
 	unsigned int m_areaCount;									// total number of nav areas
 
+	static constexpr int GRID_BLOCK_SIZE = 8;					// number of grid cells per side of a coarse grid block
+	CUtlVector<Extent> m_gridBounds;							// bounds of the areas in each grid cell, used to prune nearest area searches
+	CUtlVector<Extent> m_gridBlockBounds;						// bounds of the areas in each block of GRID_BLOCK_SIZE x GRID_BLOCK_SIZE cells
+	int m_gridBlockSizeX;
+	int m_gridBlockSizeY;
+
 	bool m_isLoaded;											// true if a Navigation Mesh has been loaded
 	bool m_isOutOfDate;											// true if the Navigation Mesh is older than the actual BSP
 	bool m_isAnalyzed;											// true if the Navigation Mesh needs analysis
@@ -1542,6 +1572,7 @@ private:
 	int WorldToGridX( float wx ) const;							// given X component, return grid index
 	int WorldToGridY( float wy ) const;							// given Y component, return grid index
 	void AllocateGrid( float minX, float maxX, float minY, float maxY );	// clear and reset the grid to the given extents
+	float ComputeGridCellSize( float minX, float maxX, float minY, float maxY ) const;	// returns the grid cell size to use for the current areas
 	void GridToWorld( int gridX, int gridY, Vector *pos ) const;
 
 	void AddNavArea( CNavArea *area );							// add an area to the grid
@@ -1636,13 +1667,35 @@ private:
 
 	CNavNode *m_currentNode;									// the current node we are sampling from
 	NavDirType m_generationDir;
-	CNavNode *AddNode( const Vector &destPos, const Vector &destNormal, NavDirType dir, CNavNode *source, bool isOnDisplacement, float obstacleHeight, float flObstacleStartDist, float flObstacleEndDist );		// add a nav node and connect it, update current node
+	CNavNode *AddNode( const Vector &destPos, const Vector &destNormal, NavDirType dir, CNavNode *source, bool isOnDisplacement, float obstacleHeight, float flObstacleStartDist, float flObstacleEndDist, bool checkCrouch = true );		// add a nav node and connect it, update current node
 
 	NavLadderVector m_ladders;									// list of ladder navigation representations
 	void BuildLadders( void );
 	void DestroyLadders( void );
 
 	bool SampleStep( void );									// sample the walkable areas of the map
+
+	// Result of a single sampling step from a node in a cardinal direction
+	struct SampleStepResult
+	{
+		Vector to;
+		Vector normal;
+		float obstacleHeight;
+		float obstacleStartDist;
+		float obstacleEndDist;
+		bool isOnDisplacement;
+	};
+
+	/**
+	 * @brief Tests if a new node can be placed one generation step away from the given position. Does not modify the mesh or the node list.
+	 * @param from Position of the source node.
+	 * @param dir Direction to step to.
+	 * @param filter Trace filter used by the step traces.
+	 * @param result Step result, only valid if this returns true.
+	 * @return True if the step is walkable and a node should be added.
+	 */
+	bool TestSampleStep( const Vector &from, NavDirType dir, ITraceFilter *filter, SampleStepResult &result ) const;
+	void SampleWalkableSpaceParallel( int numThreads );		// samples the whole map on worker threads, blocks until done
 	void CreateNavAreasFromNodes( void );						// cover all of the sampled nodes with nav areas
 
 	bool TestArea( CNavNode *node, int width, int height );		// check if an area of size (width, height) can fit, starting from node as upper left corner
@@ -1660,7 +1713,7 @@ private:
 	void FixCornerOnCornerAreas( void );
 	void FixConnections( void );
 	void SplitAreasUnderOverhangs( void );
-	void ValidateNavAreaConnections( void );
+	int ValidateNavAreaConnections( void );						// returns the number of errors found
 	void StitchGeneratedAreas( void );							// Stitches incrementally-generated areas into the existing mesh
 	void StitchAreaSet( CUtlVector< CNavArea * > *areas );		// Stitches an arbitrary set of areas into the existing mesh
 	void HandleObstacleTopAreas( void );						// Handles fixing/generating areas on top of slim obstacles such as fences and railings
@@ -1693,6 +1746,7 @@ private:
 		GENERATE_INCREMENTAL,
 		GENERATE_SIMPLIFY,
 		GENERATE_ANALYSIS_ONLY,
+		GENERATE_REGION,										// re-generating the areas inside m_simplifyGenerationExtent
 	}
 	m_generationMode;											// true while a Navigation Mesh is being generated
 	int m_generationIndex;										// used for iterating nav areas during generation process
@@ -1719,6 +1773,11 @@ private:
 	void BuildTransientAreaList( void );
 	std::vector<CNavArea*> m_transientAreas;
 
+	void BuildActiveAreaList();
+	void UpdateActiveAreas();
+	std::vector<CNavArea*> m_activeAreas;						// areas that get OnFrame and OnUpdate calls
+	std::size_t m_activeAreaCursor;								// next active area to receive OnUpdate, a pass is done when this reaches the end of the list
+
 	void UpdateAvoidanceObstacles(void);
 	void UpdateAvoidanceObstacleAreas( void );
 	void OnRoundRestart_AvoidanceObstacles(void);
@@ -1739,6 +1798,10 @@ private:
 
 	void TestAllAreasForBlockedStatus( void );					// Used to update blocked areas after a round restart. Need to delay so the map logic has all fired.
 	CountdownTimer m_updateBlockedAreasTimer;
+	CNavReachability m_reachability;
+	CNavPathCache m_pathCache;
+	CNavDangerMap m_dangerMap;
+	unsigned int m_connectivityEpoch;
 	CountdownTimer m_invokeAreaUpdateTimer;
 	CountdownTimer m_invokeWaypointUpdateTimer;
 	CountdownTimer m_invokeVolumeUpdateTimer;
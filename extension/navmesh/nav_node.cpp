@@ -276,15 +276,14 @@ float CNavNode::GetGroundHeightAboveNode( NavCornerType cornerType ) const
 /**
  * Look up to JumpCrouchHeight in the air to see if we can fit a whole navgenparams->human_height box
  */
-bool CNavNode::TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, const Vector& maxs, float *groundHeightAboveNode )
+bool CNavNode::TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, const Vector& maxs, float *groundHeightAboveNode, ITraceFilter* filter )
 {
-	CTraceFilterWalkableEntities filter( NULL, COLLISION_GROUP_PLAYER_MOVEMENT, WALK_THRU_EVERYTHING);
 	trace_t tr;
 
 	Vector start( m_pos );
 	Vector end( start );
 	end.z += navgenparams->jump_crouch_height;
-	trace::hull(start, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, tr);
+	trace::hull(start, end, CNavMesh::s_NavTraceMins, CNavMesh::s_NavTraceMaxs, TheNavMesh->GetGenerationTraceMask(), filter, tr);
 
 	float maxHeight = tr.endpos.z - start.z;
 
@@ -297,7 +296,7 @@ bool CNavNode::TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, c
 
 		realMaxs.z = navgenparams->human_crouch_height;
 
-		trace::hull(start, start, mins, realMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, tr);
+		trace::hull(start, start, mins, realMaxs, TheNavMesh->GetGenerationTraceMask(), filter, tr);
 
 		if ( !tr.startsolid )
 		{
@@ -306,7 +305,7 @@ bool CNavNode::TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, c
 			// We found a crouch-sized space.  See if we can stand up.
 			realMaxs.z = navgenparams->human_height;
 
-			trace::hull(start, start, mins, realMaxs, TheNavMesh->GetGenerationTraceMask(), &filter, tr);
+			trace::hull(start, start, mins, realMaxs, TheNavMesh->GetGenerationTraceMask(), filter, tr);
 
 			if ( !tr.startsolid )
 			{
@@ -339,8 +338,15 @@ bool CNavNode::TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, c
 
 
 //--------------------------------------------------------------------------------------------------------------
-void CNavNode::CheckCrouch( void )
+void CNavNode::CheckCrouch( ITraceFilter* filter )
 {
+	CTraceFilterWalkableEntities walkableFilter( NULL, COLLISION_GROUP_PLAYER_MOVEMENT, WALK_THRU_EVERYTHING );
+
+	if ( filter == nullptr )
+	{
+		filter = &walkableFilter;
+	}
+
 	// For each direction, trace upwards from our best ground height to VEC_HULL_MAX.z to see if we have standing room.
 	for ( int i=0; i<NUM_CORNERS; ++i )
 	{
@@ -385,7 +391,7 @@ void CNavNode::CheckCrouch( void )
 			}
 		}
 
-		if ( !TestForCrouchArea( corner, mins, maxs, &m_groundHeightAboveNode[i] ) )
+		if ( !TestForCrouchArea( corner, mins, maxs, &m_groundHeightAboveNode[i], filter ) )
 		{
 			SetAttributes( NAV_MESH_CROUCH );
 			m_crouch[corner] = true;
@@ -14,6 +14,8 @@
 
 #include "nav.h"
 
+class ITraceFilter;
+
 // If DEBUG_NAV_NODES is true, nav_show_nodes controls drawing node positions, and
 // nav_show_node_id allows you to show the IDs of nodes that didn't get used to create areas.
 #define DEBUG_NAV_NODES 1
@@ -69,8 +71,8 @@ private:
 	CNavNode() {}													// constructor used only for hash lookup
 	friend class CNavMesh;
 
-	bool TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, const Vector& maxs, float *groundHeightAboveNode );
-	void CheckCrouch( void );
+	bool TestForCrouchArea( NavCornerType cornerNum, const Vector& mins, const Vector& maxs, float *groundHeightAboveNode, ITraceFilter* filter );
+	void CheckCrouch( ITraceFilter* filter = nullptr );				///< if filter is NULL, the default walkable entities filter is used
 
 	Vector m_pos;													///< position of this node in the world
 	Vector m_normal;												///< surface normal at this location
@@ -0,0 +1,113 @@
+#include NAVBOT_PCH_FILE
+#include <extension.h>
+#include "nav_area.h"
+#include "nav_path_cache.h"
+
+static ConVar sm_navbot_path_cache("sm_navbot_path_cache", "1", FCVAR_GAMEDLL | FCVAR_DONTRECORD, "If enabled, recently computed paths are reused by bots with the same movement capabilities going between the same areas.");
+static ConVar sm_navbot_path_cache_max_age("sm_navbot_path_cache_max_age", "5", FCVAR_GAMEDLL | FCVAR_DONTRECORD, "Maximum age in seconds of a cached path. Limits how long danger decay is ignored for.", true, 0.0f, true, 60.0f);
+
+CNavPathCache::CNavPathCache()
+{
+	m_useCounter = 0U;
+	m_hits = 0U;
+	m_misses = 0U;
+	m_rejected = 0U;
+	m_entries.reserve(MAX_ENTRIES);
+}
+
+bool CNavPathCache::IsEnabled()
+{
+	return sm_navbot_path_cache.GetBool();
+}
+
+void CNavPathCache::Clear()
+{
+	m_entries.clear();
+	m_useCounter = 0U;
+}
+
+const CNavPathCache::Entry* CNavPathCache::Find(const CNavArea* startArea, const CNavArea* goalArea, int teamID, std::uint64_t costKey, unsigned int epoch, unsigned int dangerEpoch)
+{
+	const float maxAge = sm_navbot_path_cache_max_age.GetFloat();
+
+	for (Entry& entry : m_entries)
+	{
+		if (entry.lastUse == 0U || entry.startArea != startArea || entry.goalArea != goalArea || entry.teamID != teamID || entry.costKey != costKey)
+		{
+			continue;
+		}
+
+		if (entry.epoch != epoch || entry.dangerEpoch != dangerEpoch || gpGlobals->curtime - entry.timestamp > maxAge)
+		{
+			// stale, free the slot
+			entry.lastUse = 0U;
+			entry.areas.clear();
+			break;
+		}
+
+		entry.lastUse = ++m_useCounter;
+		m_hits++;
+		return &entry;
+	}
+
+	m_misses++;
+	return nullptr;
+}
+
+void CNavPathCache::Store(const CNavArea* startArea, const CNavArea* goalArea, int teamID, std::uint64_t costKey, unsigned int epoch, unsigned int dangerEpoch, float travelDistance, const std::vector<PathArea>& areas)
+{
+	Entry* slot = nullptr;
+	Entry* lru = nullptr;
+
+	for (Entry& entry : m_entries)
+	{
+		if (entry.lastUse != 0U && entry.startArea == startArea && entry.goalArea == goalArea && entry.teamID == teamID && entry.costKey == costKey)
+		{
+			slot = &entry;
+			break;
+		}
+
+		if (lru == nullptr || entry.lastUse < lru->lastUse)
+		{
+			lru = &entry;
+		}
+	}
+
+	if (slot == nullptr)
+	{
+		if (lru != nullptr && (lru->lastUse == 0U || m_entries.size() >= MAX_ENTRIES))
+		{
+			slot = lru; // free slot or evict the least recently used entry
+		}
+		else
+		{
+			slot = &m_entries.emplace_back();
+		}
+	}
+
+	slot->startArea = startArea;
+	slot->goalArea = goalArea;
+	slot->teamID = teamID;
+	slot->costKey = costKey;
+	slot->epoch = epoch;
+	slot->dangerEpoch = dangerEpoch;
+	slot->timestamp = gpGlobals->curtime;
+	slot->travelDistance = travelDistance;
+	slot->lastUse = ++m_useCounter;
+	slot->areas.assign(areas.begin(), areas.end());
+}
+
+std::size_t CNavPathCache::GetEntryCount() const
+{
+	std::size_t count = 0U;
+
+	for (const Entry& entry : m_entries)
+	{
+		if (entry.lastUse != 0U)
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
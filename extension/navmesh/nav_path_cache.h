@@ -0,0 +1,108 @@
+#ifndef NAV_MESH_PATH_CACHE_H_
+#define NAV_MESH_PATH_CACHE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "nav.h"
+
+class CNavArea;
+
+/**
+ * @brief Small LRU cache of recently computed area sequences.
+ *
+ * Entries are keyed by start area, goal area, team and a hash of the cost functor parameters.
+ * Each entry stores the nav mesh connectivity epoch it was computed at, entries from an older epoch are never returned.
+ * Paths computed with danger sensitive costs also store the team's danger epoch and are dropped once the team's danger changes.
+ * Only complete paths are stored.
+ */
+class CNavPathCache
+{
+public:
+	CNavPathCache();
+
+	static constexpr std::size_t MAX_ENTRIES = 64U;
+	static constexpr std::uint64_t HASH_SEED = 14695981039346656037ULL; // FNV-1a offset basis
+
+	struct PathArea
+	{
+		CNavArea* area;
+		NavTraverseType how;
+	};
+
+	struct Entry
+	{
+		const CNavArea* startArea;
+		const CNavArea* goalArea;
+		int teamID;
+		std::uint64_t costKey;
+		unsigned int epoch; // connectivity epoch when the path was computed
+		unsigned int dangerEpoch; // team danger epoch when the path was computed, 0 if the costs ignored danger
+		float timestamp; // time the path was computed
+		float travelDistance; // total path cost to the goal area
+		std::uint64_t lastUse; // LRU stamp, 0 for empty entries
+		std::vector<PathArea> areas; // start area to goal area
+	};
+
+	// Hashes a value into the given hash.
+	static std::uint64_t HashCombine(std::uint64_t hash, std::uint32_t value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			hash ^= static_cast<std::uint64_t>((value >> (i * 8)) & 0xFFU);
+			hash *= 1099511628211ULL; // FNV-1a prime
+		}
+
+		return hash;
+	}
+
+	static std::uint64_t HashCombine(std::uint64_t hash, float value)
+	{
+		std::uint32_t bits = 0U;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return HashCombine(hash, bits);
+	}
+
+	static bool IsEnabled();
+	// Removes all entries.
+	void Clear();
+	/**
+	 * @brief Looks up a cached path.
+	 * @param startArea Path start area.
+	 * @param goalArea Path goal area.
+	 * @param teamID Team index of the path user.
+	 * @param costKey Cost functor hash.
+	 * @param epoch Current nav mesh connectivity epoch.
+	 * @param dangerEpoch Current danger epoch of the team or 0 if the cost functor ignores danger.
+	 * @return Cached entry or NULL if there isn't an up to date entry for the given key.
+	 */
+	const Entry* Find(const CNavArea* startArea, const CNavArea* goalArea, int teamID, std::uint64_t costKey, unsigned int epoch, unsigned int dangerEpoch);
+	/**
+	 * @brief Stores a complete path, replacing the least recently used entry if the cache is full.
+	 * @param startArea Path start area.
+	 * @param goalArea Path goal area.
+	 * @param teamID Team index of the path user.
+	 * @param costKey Cost functor hash.
+	 * @param epoch Current nav mesh connectivity epoch.
+	 * @param dangerEpoch Current danger epoch of the team or 0 if the cost functor ignores danger.
+	 * @param travelDistance Total path cost to the goal area.
+	 * @param areas Area sequence, from the start area to the goal area.
+	 */
+	void Store(const CNavArea* startArea, const CNavArea* goalArea, int teamID, std::uint64_t costKey, unsigned int epoch, unsigned int dangerEpoch, float travelDistance, const std::vector<PathArea>& areas);
+	// A cached path failed validation and a search was needed anyways.
+	void OnRejectedHit() { m_rejected++; }
+
+	std::uint64_t GetHits() const { return m_hits; }
+	std::uint64_t GetMisses() const { return m_misses; }
+	std::uint64_t GetRejected() const { return m_rejected; }
+	std::size_t GetEntryCount() const;
+
+private:
+	std::vector<Entry> m_entries;
+	std::uint64_t m_useCounter;
+	std::uint64_t m_hits;
+	std::uint64_t m_misses;
+	std::uint64_t m_rejected;
+};
+
+#endif // !NAV_MESH_PATH_CACHE_H_
@@ -22,8 +22,11 @@
 #include <stdexcept>
 #include <cstdlib>
 #include <cinttypes>
+#include <memory>
+#include <limits>
 
 #include <util/librandom.h>
+#include <util/hotpath_profiler.h>
 #include "nav_area.h"
 #include "nav_elevator.h"
 
@@ -135,6 +138,8 @@ template< typename CostFunctor >
 bool NavAreaBuildPath( CNavArea *startArea, CNavArea *goalArea, const Vector *goalPos,
 		const CostFunctor &costFunc, CNavArea **closestArea = NULL, float maxPathLength = 0.0f, int teamID = NAV_TEAM_ANY, bool ignoreNavBlockers = false )
 {
+	NAVBOT_PROFILE_SCOPE("NavAreaBuildPath");
+
 	if ( closestArea )
 	{
 		*closestArea = startArea;
@@ -495,6 +500,24 @@ bool NavAreaBuildPath( CNavArea *startArea, CNavArea *goalArea, const Vector *go
 	return false;
 }
 
+/**
+ * @brief Checks if the goal area is reachable from the start area by searching from both ends at the same time.
+ *
+ * Areas on different connected components (see CNavReachability) are rejected without searching.
+ * This is a bidirectional Dijkstra over the path length, the cost functor is only used to tell if a connection can be used.
+ * The backward half walks incoming connections and calls the cost functor with the areas in the travel direction.
+ * @tparam CostFunctor NavAreaBuildPath cost functor.
+ * @param startArea Start area.
+ * @param goalArea Goal area.
+ * @param costFunc Cost functor, a negative cost means the connection can't be used.
+ * @param maxPathLength If positive, the goal must be reachable with a path no longer than this.
+ * @param teamID Team index for blocked areas.
+ * @param ignoreNavBlockers Ignore areas blocked by nav blockers.
+ * @return true if a path exists.
+ */
+template <typename CostFunctor>
+bool NavAreaIsReachableBidirectional(CNavArea* startArea, CNavArea* goalArea, const CostFunctor& costFunc, const float maxPathLength = 0.0f, const int teamID = NAV_TEAM_ANY, const bool ignoreNavBlockers = false);
+
 /**
  * @brief Checks if the goal area is reachable from the start area.
  * @tparam CostFunctor A* cost function
@@ -512,7 +535,7 @@ bool NavIsReachable(CNavArea* start, CNavArea* goal, CostFunctor& costFunc)
 	if (start == goal)
 		return true;
 
-	return NavAreaBuildPath(start, goal, nullptr, costFunc, nullptr);
+	return NavAreaIsReachableBidirectional(start, goal, costFunc);
 }
 
 
@@ -1112,6 +1135,150 @@ void SelectSeparatedShuffleSet( int maxCount, float minSeparation, const CUtlVec
 	}
 }
 
+/**
+ * @brief Reusable storage for nav mesh searches.
+ *
+ * Nodes are stored in a dense array indexed by the area ID. Nodes are not cleared between searches,
+ * each node is stamped with the search generation and nodes with an old stamp are treated as missing.
+ * @tparam N Search node type.
+ * @tparam E Open list element type.
+ */
+template <typename N, typename E>
+class NavSearchArena
+{
+public:
+	NavSearchArena()
+	{
+		m_generation = 1U;
+		m_nodes.reserve(4096);
+		m_stamps.reserve(4096);
+		m_openList.reserve(1024);
+	}
+
+	// Starts a new search, invalidating all nodes and clearing the open list
+	void Begin()
+	{
+		m_openList.clear();
+
+		if (++m_generation == 0U)
+		{
+			// wrapped around, old stamps could match again
+			std::fill(m_stamps.begin(), m_stamps.end(), 0U);
+			m_generation = 1U;
+		}
+	}
+
+	// Returns the node for the given area ID or NULL if the area wasn't reached by the current search
+	N* GetNode(const unsigned int id)
+	{
+		if (id >= m_stamps.size() || m_stamps[id] != m_generation)
+		{
+			return nullptr;
+		}
+
+		return &m_nodes[id];
+	}
+
+	const N* GetNode(const unsigned int id) const
+	{
+		if (id >= m_stamps.size() || m_stamps[id] != m_generation)
+		{
+			return nullptr;
+		}
+
+		return &m_nodes[id];
+	}
+
+	// Creates a default initialized node for the given area ID
+	N* CreateNode(const unsigned int id)
+	{
+		if (id >= m_stamps.size())
+		{
+			const std::size_t size = std::max(static_cast<std::size_t>(id) + 1U, m_stamps.size() * 2U);
+			m_nodes.resize(size);
+			m_stamps.resize(size, 0U);
+		}
+
+		m_stamps[id] = m_generation;
+		m_nodes[id] = N();
+		return &m_nodes[id];
+	}
+
+	std::vector<E>& GetOpenList() { return m_openList; }
+
+private:
+	std::vector<N> m_nodes;
+	std::vector<unsigned int> m_stamps;
+	unsigned int m_generation;
+	std::vector<E> m_openList;
+};
+
+/**
+ * @brief Borrows a search arena from a per thread pool and returns it when destroyed.
+ *
+ * Searches running at the same time (nested collectors) get different arenas. The arena is only taken from the pool on first use.
+ * Copies start without an arena.
+ * @tparam N Search node type.
+ * @tparam E Open list element type.
+ */
+template <typename N, typename E>
+class NavSearchArenaHandle
+{
+public:
+	using Arena = NavSearchArena<N, E>;
+
+	NavSearchArenaHandle() : m_arena(nullptr) {}
+	NavSearchArenaHandle(const NavSearchArenaHandle& other) : m_arena(nullptr) {}
+	~NavSearchArenaHandle() { Release(); }
+
+	NavSearchArenaHandle& operator=(const NavSearchArenaHandle& other) { return *this; }
+
+	// Gets the arena, taking one from the pool if needed. New arenas start with a new search generation.
+	Arena* Get()
+	{
+		if (m_arena == nullptr)
+		{
+			std::vector<std::unique_ptr<Arena>>& pool = GetPool();
+
+			if (pool.empty())
+			{
+				m_arena = new Arena;
+			}
+			else
+			{
+				m_arena = pool.back().release();
+				pool.pop_back();
+			}
+
+			m_arena->Begin();
+		}
+
+		return m_arena;
+	}
+
+	// Gets the arena if one was taken from the pool
+	Arena* Peek() const { return m_arena; }
+
+	// Gives the arena back to the pool
+	void Release()
+	{
+		if (m_arena != nullptr)
+		{
+			GetPool().emplace_back(m_arena);
+			m_arena = nullptr;
+		}
+	}
+
+private:
+	Arena* m_arena;
+
+	static std::vector<std::unique_ptr<Arena>>& GetPool()
+	{
+		static thread_local std::vector<std::unique_ptr<Arena>> pool;
+		return pool;
+	}
+};
+
 template <typename T>
 class INavSearchNode
 {
@@ -1166,6 +1333,192 @@ public:
 	}
 };
 
+// Open list entry for INavAreaCollector, the total cost is copied so the heap doesn't need to look up nodes
+template <typename T>
+struct NavSearchOpenEntry
+{
+	float total;
+	T* area;
+
+	// heap comparison, smallest total on top
+	bool operator<(const NavSearchOpenEntry& other) const { return total > other.total; }
+};
+
+/**
+ * @brief Search node used by NavAreaIsReachableBidirectional.
+ */
+struct NavBidirectionalNode
+{
+	float length; // path length from where this half of the search started
+	bool closed;
+};
+
+template <typename CostFunctor>
+bool NavAreaIsReachableBidirectional(CNavArea* startArea, CNavArea* goalArea, const CostFunctor& costFunc, const float maxPathLength, const int teamID, const bool ignoreNavBlockers)
+{
+	using Arena = NavSearchArena<NavBidirectionalNode, NavSearchOpenEntry<CNavArea>>;
+
+	if (startArea == nullptr || goalArea == nullptr)
+	{
+		return false;
+	}
+
+	if (startArea == goalArea)
+	{
+		return true;
+	}
+
+	if (startArea->IsBlocked(teamID, ignoreNavBlockers) || goalArea->IsBlocked(teamID, ignoreNavBlockers))
+	{
+		return false;
+	}
+
+	CNavReachability& reachability = TheNavMesh->GetReachability();
+
+	// different components, no need to search
+	if (!reachability.IsPossiblyReachable(startArea, goalArea, ignoreNavBlockers ? NAV_TEAM_ANY : teamID))
+	{
+		return false;
+	}
+
+	NavSearchArenaHandle<NavBidirectionalNode, NavSearchOpenEntry<CNavArea>> forwardHandle;
+	NavSearchArenaHandle<NavBidirectionalNode, NavSearchOpenEntry<CNavArea>> backwardHandle;
+	Arena* forward = forwardHandle.Get();
+	Arena* backward = backwardHandle.Get();
+	const bool hasMaxLength = maxPathLength > 0.0f;
+	float best = std::numeric_limits<float>::max(); // shortest start to goal length found so far
+
+	auto relax = [&best](Arena* own, const Arena* other, CNavArea* area, const float length) {
+		const unsigned int id = area->GetID();
+		NavBidirectionalNode* node = own->GetNode(id);
+
+		if (node == nullptr)
+		{
+			node = own->CreateNode(id);
+			node->closed = false;
+		}
+		else if (node->closed || node->length <= length)
+		{
+			return;
+		}
+
+		node->length = length;
+		std::vector<NavSearchOpenEntry<CNavArea>>& open = own->GetOpenList();
+		open.push_back({ length, area });
+		std::push_heap(open.begin(), open.end());
+
+		// both halves reached this area
+		const NavBidirectionalNode* otherNode = other->GetNode(id);
+
+		if (otherNode != nullptr)
+		{
+			best = std::min(best, length + otherNode->length);
+		}
+	};
+
+	relax(forward, backward, startArea, 0.0f);
+	relax(backward, forward, goalArea, 0.0f);
+
+	std::vector<NavSearchOpenEntry<CNavArea>>& forwardOpen = forward->GetOpenList();
+	std::vector<NavSearchOpenEntry<CNavArea>>& backwardOpen = backward->GetOpenList();
+
+	while (!forwardOpen.empty() && !backwardOpen.empty())
+	{
+		if (!hasMaxLength && best < std::numeric_limits<float>::max())
+		{
+			return true; // any path will do
+		}
+
+		// no unexplored path can be shorter than the best one found
+		if (forwardOpen.front().total + backwardOpen.front().total >= best)
+		{
+			break;
+		}
+
+		// expand the smaller frontier
+		const bool expandForward = forwardOpen.size() <= backwardOpen.size();
+		Arena* own = expandForward ? forward : backward;
+		std::vector<NavSearchOpenEntry<CNavArea>>& open = own->GetOpenList();
+
+		std::pop_heap(open.begin(), open.end());
+		const NavSearchOpenEntry<CNavArea> entry = open.back();
+		open.pop_back();
+
+		NavBidirectionalNode* node = own->GetNode(entry.area->GetID());
+
+		if (node->closed || entry.total > node->length)
+		{
+			continue; // stale entry
+		}
+
+		node->closed = true;
+
+		CNavArea* area = entry.area;
+		const float length = node->length;
+
+		if (expandForward)
+		{
+			auto forwardfunc = [&](CNavArea* other, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator) {
+				if (other->IsBlocked(teamID, ignoreNavBlockers))
+				{
+					return;
+				}
+
+				if (costFunc(other, area, ladder, link, elevator, link != nullptr ? link->GetConnectionLength() : -1.0f) < 0.0f)
+				{
+					return;
+				}
+
+				const float newLength = length + (other->GetCenter() - area->GetCenter()).Length();
+
+				if (hasMaxLength && newLength > maxPathLength)
+				{
+					return;
+				}
+
+				relax(forward, backward, other, newLength);
+			};
+
+			area->ForEachConnection(forwardfunc);
+		}
+		else
+		{
+			// walk connections backwards, the cost functor still sees them in the travel direction
+			auto backwardfunc = [&](const CNavReachability::IncomingConnection& connection) {
+				CNavArea* from = connection.from;
+
+				if (from->IsBlocked(teamID, ignoreNavBlockers))
+				{
+					return;
+				}
+
+				if (costFunc(area, from, connection.ladder, connection.link, connection.elevator, connection.link != nullptr ? connection.link->GetConnectionLength() : -1.0f) < 0.0f)
+				{
+					return;
+				}
+
+				const float newLength = length + (area->GetCenter() - from->GetCenter()).Length();
+
+				if (hasMaxLength && newLength > maxPathLength)
+				{
+					return;
+				}
+
+				relax(backward, forward, from, newLength);
+			};
+
+			reachability.ForEachIncomingConnection(area, backwardfunc);
+		}
+	}
+
+	if (hasMaxLength)
+	{
+		return best <= maxPathLength;
+	}
+
+	return best < std::numeric_limits<float>::max();
+}
+
 template <typename T>
 class INavAreaCollector
 {
@@ -1174,7 +1527,6 @@ public:
 	{
 		m_startArea = nullptr;
 		m_travelLimit = 999999.0f;
-		m_nodes.reserve(4096);
 		m_collected.reserve(4096);
 		m_searchLadders = true;
 		m_searchLinks = true;
@@ -1187,7 +1539,6 @@ public:
 	{
 		m_startArea = start;
 		m_travelLimit = limit;
-		m_nodes.reserve(4096);
 		m_collected.reserve(4096);
 		m_searchLadders = true;
 		m_searchLinks = true;
@@ -1200,7 +1551,6 @@ public:
 	{
 		m_startArea = start;
 		m_travelLimit = limit;
-		m_nodes.reserve(4096);
 		m_collected.reserve(4096);
 		m_searchLadders = searchLadders;
 		m_searchLinks = searchLinks;
@@ -1350,8 +1700,7 @@ protected:
 private:
 	T* m_startArea;
 	float m_travelLimit;
-	std::priority_queue<T*, std::vector<T*>, NavSearchNodeSmallestCost<T>> m_searchlist;
-	std::unordered_map<unsigned int, INavSearchNode<T>> m_nodes;
+	NavSearchArenaHandle<INavSearchNode<T>, NavSearchOpenEntry<T>> m_arena; // search nodes and the open list heap
 	std::vector<T*> m_collected;
 	bool m_searchLadders;
 	bool m_searchLinks;
@@ -1363,10 +1712,19 @@ private:
 
 	T* PopNextArea()
 	{
-		T* next = m_searchlist.top();
-		m_searchlist.pop();
+		std::vector<NavSearchOpenEntry<T>>& openList = m_arena.Get()->GetOpenList();
+		std::pop_heap(openList.begin(), openList.end());
+		T* next = openList.back().area;
+		openList.pop_back();
 		return next;
 	}
+
+	void PushArea(T* area, const float total)
+	{
+		std::vector<NavSearchOpenEntry<T>>& openList = m_arena.Get()->GetOpenList();
+		openList.push_back({ total, area });
+		std::push_heap(openList.begin(), openList.end());
+	}
 };
 
 template<typename T>
@@ -1379,12 +1737,14 @@ inline void INavAreaCollector<T>::Execute()
 
 	InitSearch();
 
-	while (!m_searchlist.empty())
+	auto arena = m_arena.Get();
+
+	while (!arena->GetOpenList().empty())
 	{
 		T* next = PopNextArea();
 
 		// All areas at the searchlist should have a valid node!
-		auto thisnode = &m_nodes.find(next->GetID())->second;
+		auto thisnode = arena->GetNode(next->GetID());
 
 		if (m_travelLimit > 0.0f && thisnode->total > m_travelLimit)
 		{
@@ -1556,48 +1916,44 @@ template<typename T>
 inline void INavAreaCollector<T>::Reset()
 {
 	m_collected.clear();
-	m_nodes.clear();
 
-	while (!m_searchlist.empty())
+	// nodes from the previous search are invalidated by the new generation, no need to clear them
+	if (m_arena.Peek() != nullptr)
 	{
-		m_searchlist.pop();
+		m_arena.Peek()->Begin();
 	}
 }
 
 template<typename T>
 inline const INavSearchNode<T>* INavAreaCollector<T>::GetNodeForArea(const T* area) const
 {
-	auto it = m_nodes.find(area->GetID());
+	const NavSearchArena<INavSearchNode<T>, NavSearchOpenEntry<T>>* arena = m_arena.Peek();
 
-	if (it == m_nodes.end())
+	if (arena == nullptr)
 	{
 		return nullptr;
 	}
 
-	return &it->second;
+	return arena->GetNode(area->GetID());
 }
 
 template<typename T>
 inline void INavAreaCollector<T>::IncludeInSearch(T* prevArea, T* area)
 {
-	if (m_nodes.find(area->GetID()) == m_nodes.end())
+	auto arena = m_arena.Get();
+
+	if (arena->GetNode(area->GetID()) == nullptr)
 	{
-		auto status = m_nodes.emplace(area->GetID(), INavSearchNode<T>(area));
-		
-		if (status.second == true)
-		{
-			auto node = &status.first->second;
-			auto prevnode = &m_nodes.find(prevArea->GetID())->second;
+		const float distAlong = arena->GetNode(prevArea->GetID())->total;
+		const float cost = ComputeCostBetweenAreas(prevArea, area);
+		auto node = arena->CreateNode(area->GetID());
 
-			node->me = area;
-			node->parent = prevArea;
-			float distAlong = prevnode->total;
-			float cost = ComputeCostBetweenAreas(prevArea, area);
-			node->cost = cost; // store the cost to go from parent to me
-			node->total = distAlong + cost; // store total cost along the path
+		node->me = area;
+		node->parent = prevArea;
+		node->cost = cost; // store the cost to go from parent to me
+		node->total = distAlong + cost; // store total cost along the path
 
-			m_searchlist.push(area);
-		}
+		PushArea(area, node->total);
 	}
 }
 
@@ -1605,18 +1961,19 @@ template<typename T>
 inline void INavAreaCollector<T>::InitSearch()
 {
 	m_endSearch = false;
-	auto status = m_nodes.emplace(m_startArea->GetID(), INavSearchNode<T>(m_startArea));
+	auto arena = m_arena.Get();
 
-	if (status.second == true)
+	if (arena->GetNode(m_startArea->GetID()) == nullptr)
 	{
-		auto node = &status.first->second;
+		const float cost = ComputeCostBetweenAreas(nullptr, m_startArea);
+		auto node = arena->CreateNode(m_startArea->GetID());
 
 		node->parent = nullptr;
 		node->me = m_startArea;
-		node->cost = ComputeCostBetweenAreas(nullptr, m_startArea);
+		node->cost = cost;
 		node->total = node->cost;
 
-		m_searchlist.push(m_startArea);
+		PushArea(m_startArea, node->total);
 	}
 }
 
@@ -1713,6 +2070,7 @@ public:
 		g = 0.0f;
 		h = 0.0f;
 		status = NodeStatus::NEW;
+		heapIndex = 0U;
 		parent = nullptr;
 	}
 
@@ -1723,6 +2081,7 @@ public:
 		g = 0.0f;
 		h = 0.0f;
 		status = NodeStatus::NEW;
+		heapIndex = 0U;
 		parent = nullptr;
 	}
 
@@ -1736,52 +2095,36 @@ public:
 	float GetHCost() const { return h; }
 	float GetFCost() const { return g + h; }
 
-	CNavArea* area;
-	float g; // g cost
-	float h; // h cost
-	NodeStatus status;
-	NavAStarNode* parent; // parent node
-};
-
-class NavNodeSmallestCost
-{
-public:
-
-	/* std::greater implementation, for searching the node with the smallest total (f) cost */
-
-	bool operator()(const NavAStarNode* lhs, const NavAStarNode* rhs)
+	// Open list ordering, smallest total (f) cost first and smallest h cost on ties
+	bool IsCheaperThan(const NavAStarNode& other) const
 	{
-		if (lhs->GetFCost() > rhs->GetFCost())
+		if (GetFCost() < other.GetFCost())
 		{
 			return true;
 		}
-		else if (lhs->GetFCost() == rhs->GetFCost())
+		else if (GetFCost() == other.GetFCost())
 		{
-			return lhs->GetHCost() > rhs->GetHCost();
+			return GetHCost() < other.GetHCost();
 		}
-		else
-		{
-			return false;
-		}
-	}
 
-	bool operator()(const NavAStarNode& lhs, const NavAStarNode& rhs)
-	{
-		if (lhs.GetFCost() > rhs.GetFCost())
-		{
-			return true;
-		}
-		else if (lhs.GetFCost() == rhs.GetFCost())
-		{
-			return lhs.GetHCost() > rhs.GetHCost();
-		}
-		else
-		{
-			return false;
-		}
+		return false;
 	}
+
+	CNavArea* area;
+	float g; // g cost
+	float h; // h cost
+	NodeStatus status;
+	std::uint32_t heapIndex; // position in the open list heap while the node is open
+	CNavArea* parent; // area this node was reached from
 };
 
+/**
+ * @brief A* search over the nav mesh.
+ *
+ * Nodes live in a dense table indexed by area ID (see NavSearchArena) and the open list is a binary heap of area IDs
+ * where each open node knows its heap position, so a cheaper route to an open node is a decrease-key instead of a duplicate entry.
+ * @tparam T Nav area class.
+ */
 template <typename T = CNavArea>
 class INavAStarSearch
 {
@@ -1793,10 +2136,16 @@ public:
 	void SetGoalArea(T* area) { goalArea = area; }
 	void SetGoalPosition(const Vector& pos) { goalPosition = pos; goalArea = nullptr; }
 
+	/**
+	 * @brief Runs the search.
+	 * @param gCostFunctor Travel cost functor, see NavAStarPathCost. A negative cost means the connection can't be used.
+	 * @param hCostFunctor Heuristic cost functor, see NavAStarHeuristicCost.
+	 */
 	template <typename CF, typename HF>
 	void DoSearch(CF& gCostFunctor, HF& hCostFunctor);
 	void Clear();
 	bool FoundPath() const { return lastResult; }
+	// Path areas, from the end area to the start area. On failure, this is a path to the area closest to the goal.
 	const std::vector<CNavArea*>& GetPath() const { return path; }
 
 	virtual void OnSuccess() {}
@@ -1805,16 +2154,22 @@ public:
 	const float GetTotalCost() const { return totalCost; }
 
 private:
+	using SearchArena = NavSearchArena<NavAStarNode, unsigned int>;
+
 	T* startArea;
 	T* goalArea;
 	Vector goalPosition;
 	bool lastResult;
 	float totalCost;
+	std::size_t nodeCount; // number of nodes created by the last search
 
-	NavAStarNode* GetNodeForArea(T* area);
-	void BuildPath(NavAStarNode* endnode);
+	void BuildPath(const SearchArena* arena, unsigned int endID);
+	static void HeapPush(SearchArena* arena, NavAStarNode* node);
+	static unsigned int HeapPop(SearchArena* arena);
+	static void HeapSiftUp(SearchArena* arena, std::size_t index);
+	static void HeapSiftDown(SearchArena* arena, std::size_t index);
 
-	std::unordered_map<unsigned int, NavAStarNode> nodes;
+	NavSearchArenaHandle<NavAStarNode, unsigned int> m_arena; // search nodes and the open list heap of area IDs
 	std::vector<CNavArea*> path;
 };
 
@@ -1826,7 +2181,7 @@ inline INavAStarSearch<T>::INavAStarSearch()
 	goalPosition.Init(0.0f, 0.0f, 0.0f);
 	lastResult = false;
 	totalCost = 0.0f;
-	nodes.reserve(1024);
+	nodeCount = 0U;
 }
 
 template<typename T>
@@ -1834,37 +2189,20 @@ inline INavAStarSearch<T>::~INavAStarSearch()
 {
 }
 
-template<typename T>
-inline NavAStarNode* INavAStarSearch<T>::GetNodeForArea(T* area)
-{
-	unsigned int id = area->GetID();
-
-	auto it = nodes.find(id);
-
-	if (it == nodes.end())
-	{
-		auto node = nodes.emplace(id, area);
-
-		if (node.second)
-		{
-			return &node.first->second;
-		}
-
-		return nullptr;
-	}
-
-	return &it->second;
-}
-
 template<typename T>
 template<typename CF, typename HF>
 inline void INavAStarSearch<T>::DoSearch(CF& gCostFunctor, HF& hCostFunctor)
 {
-	std::priority_queue<NavAStarNode*, std::vector<NavAStarNode*>, NavNodeSmallestCost> openList;
+	NAVBOT_PROFILE_SCOPE("INavAStarSearch::DoSearch");
+
+	SearchArena* arena = m_arena.Get();
 	Vector searchGoal = goalArea != nullptr ? goalArea->GetCenter() : goalPosition;
-	std::vector<CNavArea*> neighborAreas;
 	CNavArea* endArea = goalArea;
-	NavAStarNode* closest = nullptr;
+
+	arena->Begin();
+	this->path.clear();
+	this->nodeCount = 0U;
+	this->totalCost = 0.0f;
 
 	if (endArea == nullptr)
 	{
@@ -1879,10 +2217,15 @@ inline void INavAStarSearch<T>::DoSearch(CF& gCostFunctor, HF& hCostFunctor)
 		}
 	}
 
+	unsigned int closestID = startArea->GetID();
+	float closestDistance = 0.0f;
+
 	// initialize
 	{
-		NavAStarNode* startNode = GetNodeForArea(startArea);
+		NavAStarNode* startNode = arena->CreateNode(closestID);
+		++this->nodeCount;
 
+		startNode->area = startArea;
 		startNode->g = gCostFunctor(startNode->area, nullptr, nullptr, nullptr, nullptr);
 		startNode->h = hCostFunctor(startNode->area, searchGoal);
 		startNode->parent = nullptr;
@@ -1896,81 +2239,81 @@ inline void INavAStarSearch<T>::DoSearch(CF& gCostFunctor, HF& hCostFunctor)
 			return;
 		}
 
-		openList.push(startNode);
+		closestDistance = startNode->GetHCost();
+		HeapPush(arena, startNode);
 	}
 
 	// search loop
-	while (!openList.empty())
+	while (!arena->GetOpenList().empty())
 	{
-		neighborAreas.clear();
-		NavAStarNode* current = openList.top();
-		closest = current;
+		const unsigned int currentID = HeapPop(arena);
+		NavAStarNode* current = arena->GetNode(currentID);
+		current->Close();
+
+		// creating nodes may grow the table, copy what's needed instead of keeping the pointer
 		CNavArea* area = current->area;
-		openList.pop(); // remove current from openList
-		current->Close(); // mark as closed
+		const float currentCost = current->GetGCost();
 
-		if (current->area == endArea)
+		if (area == endArea)
 		{
 			// reached
 			this->lastResult = true;
-			this->totalCost = current->GetGCost();
-			BuildPath(current);
+			this->totalCost = currentCost;
+			BuildPath(arena, currentID);
 			OnSuccess();
 			return;
 		}
 
-		// Collect neighbors
-		auto collectneighborsfunc = [&neighborAreas](CNavArea* other) {
-			neighborAreas.push_back(other);
-		};
-		area->ForEachConnectedArea(collectneighborsfunc);
-
-		for (auto neighbor : neighborAreas)
-		{
-			NavAStarNode* node = GetNodeForArea(neighbor);
+		auto relaxfunc = [&](CNavArea* neighbor, const CNavLadder* ladder, const NavOffMeshConnection* offmeshlink, const CNavElevator* elevator) {
+			const unsigned int id = neighbor->GetID();
+			NavAStarNode* node = arena->GetNode(id);
 
-			if (node->IsClosed())
+			if (node != nullptr && node->IsClosed())
 			{
-				continue; // skip closed nodes
+				return; // skip closed nodes
 			}
 
-			const NavOffMeshConnection* offmeshlink = area->GetOffMeshConnectionToArea(neighbor);
-			const CNavLadder* ladder = area->GetLadderConnectionToArea(neighbor);
-			const CNavElevator* elevator = area->GetElevatorConnectionToArea(neighbor);
-
 			float costf = gCostFunctor(neighbor, area, ladder, offmeshlink, elevator);
 
 			if (costf < 0.0f)
 			{
-				// dead end
-				node->Close();
-				continue;
+				return; // this connection can't be used, the area may still be reachable by another one
 			}
 
-			float newCost = current->GetGCost() + costf;
+			float newCost = currentCost + costf;
 
-			if (newCost < node->GetGCost() || node->IsStatusUndefined())
+			if (node == nullptr)
 			{
+				node = arena->CreateNode(id);
+				++this->nodeCount;
+				node->area = neighbor;
 				node->g = newCost;
 				node->h = hCostFunctor(neighbor, searchGoal);
-				node->parent = current;
+				node->parent = area;
+				node->Open();
 
-				if (node->IsStatusUndefined())
+				if (node->GetHCost() < closestDistance)
 				{
-					node->Open();
-					openList.push(node);
+					closestDistance = node->GetHCost();
+					closestID = id;
 				}
-			}
-		}
-	}
 
-	this->lastResult = false;
+				HeapPush(arena, node);
+			}
+			else if (newCost < node->GetGCost())
+			{
+				// decrease-key
+				node->g = newCost;
+				node->parent = area;
+				HeapSiftUp(arena, node->heapIndex);
+			}
+		};
 
-	if (closest != nullptr)
-	{
-		BuildPath(closest);
+		area->ForEachConnection(relaxfunc);
 	}
 
+	this->lastResult = false;
+	BuildPath(arena, closestID);
 	OnFailure();
 }
 
@@ -1978,33 +2321,40 @@ template<typename T>
 inline void INavAStarSearch<T>::Clear()
 {
 	this->path.clear();
-	this->nodes.clear();
 	this->lastResult = false;
+	this->totalCost = 0.0f;
+	this->nodeCount = 0U;
+
+	SearchArena* arena = m_arena.Peek();
+
+	if (arena != nullptr)
+	{
+		arena->Begin();
+	}
 }
 
 template<typename T>
-inline void INavAStarSearch<T>::BuildPath(NavAStarNode* endnode)
+inline void INavAStarSearch<T>::BuildPath(const SearchArena* arena, unsigned int endID)
 {
 #ifdef EXT_DEBUG
 	size_t i = 0;
 #endif
 
-	NavAStarNode* next = endnode;
-	path.reserve(nodes.size());
+	const NavAStarNode* next = arena->GetNode(endID);
 
 	for (;;)
 	{
 		this->path.push_back(next->area);
 
-		if (next->area == this->startArea)
+		if (next->area == this->startArea || next->parent == nullptr)
 		{
 			return;
 		}
 
-		next = next->parent;
+		next = arena->GetNode(next->parent->GetID());
 
 #ifdef EXT_DEBUG
-		if (++i >= (nodes.size() + 10U))
+		if (++i >= (nodeCount + 10U))
 		{
 			throw std::runtime_error("Infinite Loop!");
 		}
@@ -2017,6 +2367,100 @@ inline void INavAStarSearch<T>::BuildPath(NavAStarNode* endnode)
 	}
 }
 
+template<typename T>
+inline void INavAStarSearch<T>::HeapPush(SearchArena* arena, NavAStarNode* node)
+{
+	std::vector<unsigned int>& heap = arena->GetOpenList();
+	heap.push_back(node->area->GetID());
+	HeapSiftUp(arena, heap.size() - 1U);
+}
+
+template<typename T>
+inline unsigned int INavAStarSearch<T>::HeapPop(SearchArena* arena)
+{
+	std::vector<unsigned int>& heap = arena->GetOpenList();
+	const unsigned int top = heap.front();
+	heap.front() = heap.back();
+	heap.pop_back();
+
+	if (!heap.empty())
+	{
+		HeapSiftDown(arena, 0U);
+	}
+
+	return top;
+}
+
+template<typename T>
+inline void INavAStarSearch<T>::HeapSiftUp(SearchArena* arena, std::size_t index)
+{
+	std::vector<unsigned int>& heap = arena->GetOpenList();
+	const unsigned int id = heap[index];
+	NavAStarNode* node = arena->GetNode(id);
+
+	while (index > 0U)
+	{
+		const std::size_t parentIndex = (index - 1U) / 2U;
+		NavAStarNode* parentNode = arena->GetNode(heap[parentIndex]);
+
+		if (!node->IsCheaperThan(*parentNode))
+		{
+			break;
+		}
+
+		heap[index] = heap[parentIndex];
+		parentNode->heapIndex = static_cast<std::uint32_t>(index);
+		index = parentIndex;
+	}
+
+	heap[index] = id;
+	node->heapIndex = static_cast<std::uint32_t>(index);
+}
+
+template<typename T>
+inline void INavAStarSearch<T>::HeapSiftDown(SearchArena* arena, std::size_t index)
+{
+	std::vector<unsigned int>& heap = arena->GetOpenList();
+	const std::size_t size = heap.size();
+	const unsigned int id = heap[index];
+	NavAStarNode* node = arena->GetNode(id);
+
+	for (;;)
+	{
+		std::size_t child = index * 2U + 1U;
+
+		if (child >= size)
+		{
+			break;
+		}
+
+		NavAStarNode* childNode = arena->GetNode(heap[child]);
+
+		if (child + 1U < size)
+		{
+			NavAStarNode* rightNode = arena->GetNode(heap[child + 1U]);
+
+			if (rightNode->IsCheaperThan(*childNode))
+			{
+				++child;
+				childNode = rightNode;
+			}
+		}
+
+		if (!childNode->IsCheaperThan(*node))
+		{
+			break;
+		}
+
+		heap[index] = heap[child];
+		childNode->heapIndex = static_cast<std::uint32_t>(index);
+		index = child;
+	}
+
+	heap[index] = id;
+	node->heapIndex = static_cast<std::uint32_t>(index);
+}
+
 template <typename T = CNavArea>
 class INavFloodFill
 {
@@ -2025,9 +2469,6 @@ public:
 	{
 		m_startArea = nullptr;
 		m_travelLimit = -1.0f;
-		m_searchedAreas.reserve(4096);
-		m_travelCost.reserve(4096);
-		m_parents.reserve(4096);
 		m_searchLadders = true;
 		m_searchOffmeshLinks = true;
 		m_searchElevators = true;
@@ -2037,9 +2478,6 @@ public:
 	{
 		m_startArea = start;
 		m_travelLimit = -1.0f;
-		m_searchedAreas.reserve(4096);
-		m_travelCost.reserve(4096);
-		m_parents.reserve(4096);
 		m_searchLadders = true;
 		m_searchOffmeshLinks = true;
 		m_searchElevators = true;
@@ -2049,9 +2487,6 @@ public:
 	{
 		m_startArea = start;
 		m_travelLimit = travelLimit;
-		m_searchedAreas.reserve(4096);
-		m_travelCost.reserve(4096);
-		m_parents.reserve(4096);
 		m_searchLadders = true;
 		m_searchOffmeshLinks = true;
 		m_searchElevators = true;
@@ -2061,9 +2496,6 @@ public:
 	{
 		m_startArea = start;
 		m_travelLimit = travelLimit;
-		m_searchedAreas.reserve(4096);
-		m_travelCost.reserve(4096);
-		m_parents.reserve(4096);
 		m_searchLadders = searchLadders;
 		m_searchOffmeshLinks = searchOffMeshLinks;
 		m_searchElevators = searchElevators;
@@ -2074,13 +2506,9 @@ public:
 	// Reset for a new search
 	void Reset()
 	{
-		m_searchedAreas.clear();
-		m_travelCost.clear();
-		m_parents.clear();
-
-		while (!m_searchAreas.empty())
+		if (m_arena.Peek() != nullptr)
 		{
-			m_searchAreas.pop();
+			m_arena.Peek()->Begin();
 		}
 	}
 
@@ -2113,24 +2541,23 @@ public:
 	virtual float operator()(T* toArea, T* fromArea, const float fromCost, const NavOffMeshConnection* link, const CNavLadder* ladder, const CNavElevator* elevator);
 
 private:
+	// an area has been searched if it has a node
+	struct FloodNode
+	{
+		T* parent;
+		float cost;
+	};
+
 	T* m_startArea; // flood start area
 	float m_travelLimit;
-	std::unordered_set<unsigned int> m_searchedAreas;
-	std::unordered_map<unsigned int, float> m_travelCost;
-	std::unordered_map<unsigned int, T*> m_parents;
-	std::queue<T*> m_searchAreas;
+	NavSearchArenaHandle<FloodNode, T*> m_arena; // the open list is used as a FIFO queue
 	bool m_searchLadders;
 	bool m_searchOffmeshLinks;
 	bool m_searchElevators;
 
 	bool AlreadySearched(T* area)
 	{
-		return m_searchedAreas.find(area->GetID()) != m_searchedAreas.end();
-	}
-
-	T* GetParentForArea(T* area)
-	{
-		return m_parents[area->GetID()];
+		return m_arena.Get()->GetNode(area->GetID()) != nullptr;
 	}
 
 	void OnAreaBeingSearched(T* area, T* parent, const float parentCost, const NavOffMeshConnection* offmeshlink = nullptr, const CNavLadder* ladder = nullptr, const CNavElevator* elevator = nullptr);
@@ -2144,19 +2571,23 @@ inline void INavFloodFill<T>::Execute()
 		return;
 	}
 
-	m_searchAreas.push(m_startArea);
-	m_searchedAreas.insert(m_startArea->GetID());
-	m_travelCost[m_startArea->GetID()] = this->operator()(m_startArea, nullptr, 0.0f, nullptr, nullptr, nullptr);
-	m_parents[m_startArea->GetID()] = nullptr;
+	auto arena = m_arena.Get();
+	std::vector<T*>& queue = arena->GetOpenList();
+	queue.clear();
 
+	const float startCost = this->operator()(m_startArea, nullptr, 0.0f, nullptr, nullptr, nullptr);
+	FloodNode* startNode = arena->CreateNode(m_startArea->GetID());
+	startNode->parent = nullptr;
+	startNode->cost = startCost;
+	queue.push_back(m_startArea);
 
-	while (!m_searchAreas.empty())
+	// FIFO, areas are never removed from the vector until the search is done
+	for (std::size_t head = 0; head < queue.size(); head++)
 	{
-		T* nextArea = m_searchAreas.front();
-		unsigned int nextID = nextArea->GetID();
-		m_searchAreas.pop();
-		T* parentArea = GetParentForArea(nextArea);
-		float currentCost = m_travelCost[nextArea->GetID()];
+		T* nextArea = queue[head];
+		const FloodNode* nextNode = arena->GetNode(nextArea->GetID());
+		T* parentArea = nextNode->parent;
+		float currentCost = nextNode->cost;
 
 		if (m_travelLimit > 0.0f && currentCost > m_travelLimit)
 		{
@@ -2169,7 +2600,7 @@ inline void INavFloodFill<T>::Execute()
 		}
 		else
 		{
-			float cost = m_travelCost[parentArea->GetID()];
+			float cost = arena->GetNode(parentArea->GetID())->cost;
 			this->operator()(nextArea, parentArea, cost);
 		}
 
@@ -2288,10 +2719,12 @@ inline float INavFloodFill<T>::operator()(T* toArea, T* fromArea, const float fr
 template<typename T>
 inline void INavFloodFill<T>::OnAreaBeingSearched(T* area, T* parent, const float parentCost, const NavOffMeshConnection* offmeshlink, const CNavLadder* ladder, const CNavElevator* elevator)
 {
-	m_searchedAreas.insert(area->GetID());
-	m_travelCost[area->GetID()] = this->operator()(area, parent, parentCost, offmeshlink, ladder, elevator);
-	m_parents[area->GetID()] = parent;
-	m_searchAreas.push(area);
+	auto arena = m_arena.Get();
+	const float cost = this->operator()(area, parent, parentCost, offmeshlink, ladder, elevator);
+	FloodNode* node = arena->CreateNode(area->GetID());
+	node->parent = parent;
+	node->cost = cost;
+	arena->GetOpenList().push_back(area);
 }
 
 #endif // _NAV_PATHFIND_H_
\ No newline at end of file
@@ -0,0 +1,356 @@
+#include NAVBOT_PCH_FILE
+#include <unordered_set>
+#include <extension.h>
+#include "nav_mesh.h"
+#include "nav_area.h"
+#include "nav_reachability.h"
+
+CNavReachability::CNavReachability()
+{
+	m_graphValid = false;
+	m_dirty = false;
+
+	for (auto& data : m_labels)
+	{
+		data.valid = false;
+		data.nextLabel = 1U;
+	}
+}
+
+void CNavReachability::Update(bool isEditing)
+{
+	if (isEditing)
+	{
+		// ladder, elevator and link edits don't go through the area connection functions
+		Invalidate();
+		return;
+	}
+
+	if (!m_graphValid)
+	{
+		return;
+	}
+
+	// blocked status changes are notified, the timer catches anything else
+	if (!m_dirty && !m_refreshTimer.IsElapsed())
+	{
+		return;
+	}
+
+	m_dirty = false;
+	m_refreshTimer.Start(1.0f);
+
+	for (std::size_t i = 0; i < STATIC_LABELS_INDEX; i++)
+	{
+		if (m_labels[i].valid)
+		{
+			RefreshLabels(m_labels[i], static_cast<int>(i));
+		}
+	}
+}
+
+unsigned int CNavReachability::GetComponent(const CNavArea* area, int teamID)
+{
+	Labels& data = GetLabels(teamID);
+	const std::size_t id = static_cast<std::size_t>(area->GetID());
+
+	if (id >= data.labels.size())
+	{
+		return INVALID_LABEL;
+	}
+
+	return data.labels[id];
+}
+
+bool CNavReachability::IsPossiblyReachable(const CNavArea* from, const CNavArea* to, int teamID)
+{
+	if (from == to)
+	{
+		return true;
+	}
+
+	// labels may be stale, never reject a goal that could have become reachable
+	if (m_dirty)
+	{
+		return true;
+	}
+
+	const unsigned int fromLabel = GetComponent(from, teamID);
+	const unsigned int toLabel = GetComponent(to, teamID);
+
+	// blocked or new areas can't be ruled out here
+	if (fromLabel == INVALID_LABEL || toLabel == INVALID_LABEL)
+	{
+		return true;
+	}
+
+	return fromLabel == toLabel;
+}
+
+std::size_t CNavReachability::GetComponentCount(int teamID)
+{
+	Labels& data = GetLabels(teamID);
+	std::unordered_set<unsigned int> components;
+
+	for (const unsigned int label : data.labels)
+	{
+		if (label != INVALID_LABEL)
+		{
+			components.insert(label);
+		}
+	}
+
+	return components.size();
+}
+
+void CNavReachability::BuildGraph()
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CNavReachability::BuildGraph", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	std::size_t size = 0U;
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		size = std::max(size, static_cast<std::size_t>(TheNavAreas[it]->GetID()) + 1U);
+	}
+
+	// count the incoming connections of each area, then fill them in place
+	m_incomingOffsets.assign(size + 1U, 0U);
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		auto countfunc = [this](CNavArea* other, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator) {
+			m_incomingOffsets[other->GetID() + 1U]++;
+		};
+
+		TheNavAreas[it]->ForEachConnection(countfunc);
+	}
+
+	for (std::size_t i = 1U; i < m_incomingOffsets.size(); i++)
+	{
+		m_incomingOffsets[i] += m_incomingOffsets[i - 1U];
+	}
+
+	m_incomingConnections.resize(m_incomingOffsets.back());
+	std::vector<std::size_t> next(m_incomingOffsets.begin(), m_incomingOffsets.end() - 1);
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+
+		auto fillfunc = [this, &next, &area](CNavArea* other, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator) {
+			IncomingConnection& connection = m_incomingConnections[next[other->GetID()]++];
+			connection.from = area;
+			connection.ladder = ladder;
+			connection.link = link;
+			connection.elevator = elevator;
+		};
+
+		area->ForEachConnection(fillfunc);
+	}
+
+	for (auto& data : m_labels)
+	{
+		data.valid = false;
+	}
+
+	m_graphValid = true;
+	m_dirty = false; // labels are computed from the current blocked status
+	m_refreshTimer.Start(1.0f);
+}
+
+bool CNavReachability::GetIncomingRange(const CNavArea* area, std::size_t& begin, std::size_t& end)
+{
+	if (!m_graphValid)
+	{
+		BuildGraph();
+	}
+
+	const std::size_t id = static_cast<std::size_t>(area->GetID());
+
+	if (id + 1U >= m_incomingOffsets.size())
+	{
+		return false;
+	}
+
+	begin = m_incomingOffsets[id];
+	end = m_incomingOffsets[id + 1U];
+	return true;
+}
+
+CNavReachability::Labels& CNavReachability::GetLabels(int teamID)
+{
+	if (!m_graphValid)
+	{
+		BuildGraph();
+	}
+
+	Labels& data = m_labels[GetLabelIndex(teamID)];
+
+	if (!data.valid)
+	{
+		ComputeLabels(data, teamID);
+	}
+
+	return data;
+}
+
+void CNavReachability::ComputeLabels(Labels& data, int teamID)
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CNavReachability::ComputeLabels", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	const bool useBlocked = GetLabelIndex(teamID) != STATIC_LABELS_INDEX;
+	const std::size_t size = m_incomingOffsets.empty() ? 0U : m_incomingOffsets.size() - 1U;
+
+	data.labels.assign(size, INVALID_LABEL);
+	data.blocked.assign(size, false);
+	data.nextLabel = 1U;
+
+	if (useBlocked)
+	{
+		FOR_EACH_VEC(TheNavAreas, it)
+		{
+			CNavArea* area = TheNavAreas[it];
+
+			if (area->GetID() < size)
+			{
+				data.blocked[area->GetID()] = area->IsBlocked(teamID);
+			}
+		}
+	}
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+		const unsigned int id = area->GetID();
+
+		if (id < size && !data.blocked[id] && data.labels[id] == INVALID_LABEL)
+		{
+			FloodLabel(data, area, data.nextLabel++);
+		}
+	}
+
+	data.valid = true;
+}
+
+void CNavReachability::RefreshLabels(Labels& data, int teamID)
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CNavReachability::RefreshLabels", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	if (data.nextLabel >= 0x7FFFFFFFU)
+	{
+		ComputeLabels(data, teamID);
+		return;
+	}
+
+	std::unordered_set<unsigned int> splitLabels;
+	std::vector<CNavArea*> unblocked;
+
+	FOR_EACH_VEC(TheNavAreas, it)
+	{
+		CNavArea* area = TheNavAreas[it];
+		const unsigned int id = area->GetID();
+
+		if (id >= data.labels.size())
+		{
+			continue; // created after the labels were computed
+		}
+
+		const bool isBlocked = area->IsBlocked(teamID);
+
+		if (isBlocked == data.blocked[id])
+		{
+			continue;
+		}
+
+		data.blocked[id] = isBlocked;
+
+		if (isBlocked)
+		{
+			// the component may have been split in two or more
+			if (data.labels[id] != INVALID_LABEL)
+			{
+				splitLabels.insert(data.labels[id]);
+				data.labels[id] = INVALID_LABEL;
+			}
+		}
+		else
+		{
+			unblocked.push_back(area);
+		}
+	}
+
+	if (!splitLabels.empty())
+	{
+		std::vector<CNavArea*> relabel;
+
+		FOR_EACH_VEC(TheNavAreas, it)
+		{
+			CNavArea* area = TheNavAreas[it];
+			const unsigned int id = area->GetID();
+
+			if (id < data.labels.size() && data.labels[id] != INVALID_LABEL && splitLabels.find(data.labels[id]) != splitLabels.end())
+			{
+				data.labels[id] = INVALID_LABEL;
+				relabel.push_back(area);
+			}
+		}
+
+		for (CNavArea* area : relabel)
+		{
+			if (data.labels[area->GetID()] == INVALID_LABEL)
+			{
+				FloodLabel(data, area, data.nextLabel++);
+			}
+		}
+	}
+
+	// newly unblocked areas join (and merge) the components around them
+	for (CNavArea* area : unblocked)
+	{
+		if (data.labels[area->GetID()] == INVALID_LABEL)
+		{
+			FloodLabel(data, area, data.nextLabel++);
+		}
+	}
+}
+
+void CNavReachability::FloodLabel(Labels& data, CNavArea* seed, unsigned int label)
+{
+	m_stack.clear();
+	m_stack.push_back(seed);
+	data.labels[seed->GetID()] = label;
+
+	auto visit = [this, &data, &label](CNavArea* other) {
+		const unsigned int id = other->GetID();
+
+		if (id < data.labels.size() && !data.blocked[id] && data.labels[id] != label)
+		{
+			data.labels[id] = label;
+			m_stack.push_back(other);
+		}
+	};
+
+	auto forwardfunc = [&visit](CNavArea* other, const CNavLadder* ladder, const NavOffMeshConnection* link, const CNavElevator* elevator) {
+		visit(other);
+	};
+
+	auto backwardfunc = [&visit](const IncomingConnection& connection) {
+		visit(connection.from);
+	};
+
+	while (!m_stack.empty())
+	{
+		CNavArea* area = m_stack.back();
+		m_stack.pop_back();
+
+		area->ForEachConnection(forwardfunc);
+		ForEachIncomingConnection(area, backwardfunc);
+	}
+}
@@ -0,0 +1,128 @@
+#ifndef NAV_MESH_REACHABILITY_H_
+#define NAV_MESH_REACHABILITY_H_
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <sdkports/sdk_timers.h>
+#include "nav_consts.h"
+
+class CNavArea;
+class CNavLadder;
+class CNavElevator;
+class NavOffMeshConnection;
+
+/**
+ * @brief Connected component labels for nav areas, used to reject unreachable goals before running a search.
+ *
+ * Connections are treated as undirected when labeling, two areas with different labels can never reach each other
+ * but areas with the same label may still be unreachable (one way drops, cost functor restrictions).
+ * Each team has its own labels where areas blocked for that team are left out. These are refreshed incrementally:
+ * an area that becomes unblocked merges its neighbors' components and an area that becomes blocked relabels only the component it was part of.
+ * Also stores the incoming connections of each area for searches that run backwards from the goal.
+ */
+class CNavReachability
+{
+public:
+	CNavReachability();
+
+	static constexpr unsigned int INVALID_LABEL = 0U;
+
+	// A connection leading into an area
+	struct IncomingConnection
+	{
+		CNavArea* from;
+		const CNavLadder* ladder;
+		const NavOffMeshConnection* link;
+		const CNavElevator* elevator;
+	};
+
+	// The nav mesh connections changed, everything is rebuilt on the next query
+	void Invalidate() { m_graphValid = false; }
+	// The blocked status of some areas changed, the team labels are refreshed on the next update
+	void MarkDirty() { m_dirty = true; }
+	// Refreshes the team labels from the areas' current blocked status. Runs on the next update after MarkDirty, otherwise throttled.
+	void Update(bool isEditing);
+
+	/**
+	 * @brief Gets the component label of an area.
+	 * @param area Area to get the label of.
+	 * @param teamID Team index, areas blocked for this team are not part of any component.
+	 * Values out of the per team data range (NAV_TEAM_ANY) ignore the blocked status.
+	 * @return Component label or INVALID_LABEL if the area is blocked or unknown.
+	 */
+	unsigned int GetComponent(const CNavArea* area, int teamID = NAV_TEAM_ANY);
+	/**
+	 * @brief Quick reachability test. A false result means there is no path for sure, true means a search is needed to know.
+	 * @param from Start area.
+	 * @param to Goal area.
+	 * @param teamID Team index, see GetComponent.
+	 * @return false if the areas are on different components. Always true while a label refresh is pending.
+	 */
+	bool IsPossiblyReachable(const CNavArea* from, const CNavArea* to, int teamID = NAV_TEAM_ANY);
+	// Number of components for the given team
+	std::size_t GetComponentCount(int teamID = NAV_TEAM_ANY);
+
+	/**
+	 * @brief Runs a function on each connection leading into the given area.
+	 * @tparam T A class with operator() overload or a lambda expression with 1 parameter void (const IncomingConnection& connection)
+	 * @param area Area to get the incoming connections of.
+	 * @param functor function to run.
+	 */
+	template <typename T>
+	void ForEachIncomingConnection(const CNavArea* area, T& functor);
+
+private:
+	struct Labels
+	{
+		bool valid;
+		unsigned int nextLabel;
+		std::vector<unsigned int> labels; // indexed by area ID
+		std::vector<bool> blocked; // blocked status when labeled, indexed by area ID
+	};
+
+	static constexpr std::size_t STATIC_LABELS_INDEX = static_cast<std::size_t>(NAV_TEAMS_ARRAY_SIZE);
+
+	bool m_graphValid;
+	bool m_dirty; // blocked status changed since the last label refresh
+	std::vector<std::size_t> m_incomingOffsets; // indexed by area ID, range in m_incomingConnections
+	std::vector<IncomingConnection> m_incomingConnections;
+	std::array<Labels, NAV_TEAMS_ARRAY_SIZE + 1U> m_labels; // the last entry ignores blocked status
+	std::vector<CNavArea*> m_stack;
+	CountdownTimer m_refreshTimer;
+
+	void BuildGraph();
+	bool GetIncomingRange(const CNavArea* area, std::size_t& begin, std::size_t& end);
+	Labels& GetLabels(int teamID);
+	void ComputeLabels(Labels& data, int teamID);
+	void RefreshLabels(Labels& data, int teamID);
+	void FloodLabel(Labels& data, CNavArea* seed, unsigned int label);
+	std::size_t GetLabelIndex(int teamID) const
+	{
+		if (teamID < 0 || teamID >= static_cast<int>(NAV_TEAMS_ARRAY_SIZE))
+		{
+			return STATIC_LABELS_INDEX;
+		}
+
+		return static_cast<std::size_t>(teamID);
+	}
+};
+
+template<typename T>
+inline void CNavReachability::ForEachIncomingConnection(const CNavArea* area, T& functor)
+{
+	std::size_t begin = 0U;
+	std::size_t end = 0U;
+
+	if (!GetIncomingRange(area, begin, end))
+	{
+		return;
+	}
+
+	for (std::size_t i = begin; i < end; i++)
+	{
+		functor(m_incomingConnections[i]);
+	}
+}
+
+#endif // !NAV_MESH_REACHABILITY_H_
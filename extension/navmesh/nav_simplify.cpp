@@ -12,6 +12,7 @@
 #include "nav_area.h"
 #include "nav_node.h"
 #include <eiface.h>
+#include <vector>
 
 extern ConVar sm_nav_snap_to_grid;
 extern ConVar sm_nav_split_place_on_ground;
@@ -129,7 +130,7 @@ void CNavMesh::GenerateNodes( const Extent &bounds )
 	m_simplifyGenerationExtent = bounds;
 	m_seedIdx = 0;
 
-	Assert( m_generationMode == GENERATE_SIMPLIFY );
+	Assert( m_generationMode == GENERATE_SIMPLIFY || m_generationMode == GENERATE_REGION );
 	while ( SampleStep() )
 	{
 		// do nothing
@@ -283,3 +284,151 @@ CON_COMMAND_F(sm_nav_simplify_selected, "Chops all selected areas into their com
 	Msg( "%d areas simplified - %d remain\n", selectedSetSize, TheNavMesh->GetSelecteSetSize() );
 }
 
+
+//--------------------------------------------------------------------------------------------------------
+/**
+ * Re-generates the nav mesh inside the given bounds.
+ * Only the areas overlapping the bounds are destroyed, the walkable space they covered is sampled again and
+ * the new areas are merged and stitched into the surrounding mesh. Areas outside the bounds keep their IDs,
+ * attributes and connections.
+ */
+void CNavMesh::RegenerateRegion( const Extent &bounds )
+{
+	std::vector<CNavArea *> oldAreas;
+	CollectAreasOverlappingExtent( bounds, oldAreas );
+
+	ClearWalkableSeeds();
+	ClearSelectedSet();
+	SetMarkedArea( NULL );
+
+	// the sampled region must cover everything the old areas covered, or holes will be left behind
+	Extent region = bounds;
+
+	for ( CNavArea *area : oldAreas )
+	{
+		Extent areaExtent;
+		area->GetExtent( &areaExtent );
+		region.Encompass( areaExtent );
+
+		Vector center = area->GetCenter();
+		center.x = SnapToGrid( center.x );
+		center.y = SnapToGrid( center.y );
+
+		Vector normal;
+		if ( FindGroundForNode( &center, &normal ) )
+		{
+			AddWalkableSeed( center, normal );
+		}
+	}
+
+	// seed from the middle of the region too, in case the box is over a new walkable space
+	Vector center = ( bounds.lo + bounds.hi ) * 0.5f;
+	center.x = SnapToGrid( center.x );
+	center.y = SnapToGrid( center.y );
+	center.z = bounds.hi.z;
+
+	Vector normal;
+	if ( FindGroundForNode( &center, &normal ) && bounds.Contains( center ) )
+	{
+		AddWalkableSeed( center, normal );
+	}
+
+	if ( m_walkableSeeds.empty() )
+	{
+		Warning( "No walkable space found inside the region!\n" );
+		return;
+	}
+
+	region.lo.z -= navgenparams->human_height;
+	region.hi.z += 2 * navgenparams->human_height;
+
+	for ( CNavArea *area : oldAreas )
+	{
+		RemoveAndDestroyArea( area );
+	}
+
+	m_generationMode = GENERATE_REGION;
+
+	RemoveNodes();
+	GenerateNodes( region );
+	ClearWalkableSeeds();
+
+	const unsigned int numNodes = CNavNode::GetListLength();
+
+	// areas that already exist don't have nodes, the post-processing passes only touch the new areas
+	CreateNavAreasFromNodes();
+
+	BeginCustomAnalysis( true );
+
+	FOR_EACH_VEC( TheNavAreas, it )
+	{
+		CNavArea *area = TheNavAreas[ it ];
+
+		if ( area->HasNodes() )
+		{
+			area->CustomAnalysis( true );
+			AddToSelectedSet( area );
+		}
+	}
+
+	PostCustomAnalysis();
+	EndCustomAnalysis();
+
+	RemoveNodes();
+
+	// the new areas don't have hiding spots, encounter spots, etc
+	m_isAnalyzed = false;
+	m_generationMode = GENERATE_NONE;
+
+	Msg( "Region re-generated: %zu areas removed, %d areas created from %u nodes.\n", oldAreas.size(), GetSelecteSetSize(), numNodes );
+}
+
+//--------------------------------------------------------------------------------------------------------
+CON_COMMAND_F(sm_nav_regenerate_region, "Re-generates the nav mesh inside a box. Usage: sm_nav_regenerate_region <x1> <y1> <z1> <x2> <y2> <z2>. Without arguments, the bounds of the selected set are used.", FCVAR_CHEAT )
+{
+	DECLARE_COMMAND_ARGS;
+
+	if ( !UTIL_IsCommandIssuedByServerAdmin() )
+		return;
+
+	if ( TheNavMesh->IsGenerating() )
+	{
+		Msg( "Cannot re-generate a region while the nav mesh is being generated!\n" );
+		return;
+	}
+
+	Extent bounds;
+
+	if ( args.ArgC() >= 7 )
+	{
+		Vector a( atof( args[1] ), atof( args[2] ), atof( args[3] ) );
+		Vector b( atof( args[4] ), atof( args[5] ), atof( args[6] ) );
+		bounds.lo.Init( MIN( a.x, b.x ), MIN( a.y, b.y ), MIN( a.z, b.z ) );
+		bounds.hi.Init( MAX( a.x, b.x ), MAX( a.y, b.y ), MAX( a.z, b.z ) );
+	}
+	else
+	{
+		if ( TheNavMesh->IsSelectedSetEmpty() )
+		{
+			Msg( "Usage: sm_nav_regenerate_region <x1> <y1> <z1> <x2> <y2> <z2> or select the areas to re-generate.\n" );
+			return;
+		}
+
+		NavAreaCollector collector;
+		TheNavMesh->ForAllSelectedAreas( collector );
+
+		bounds.lo.Init( FLT_MAX, FLT_MAX, FLT_MAX );
+		bounds.hi.Init( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+
+		for ( int i = 0; i < collector.m_area.Count(); ++i )
+		{
+			Extent areaExtent;
+			collector.m_area[i]->GetExtent( &areaExtent );
+			bounds.Encompass( areaExtent );
+		}
+
+		bounds.hi.z += navgenparams->human_height;
+	}
+
+	TheNavMesh->RegenerateRegion( bounds );
+}
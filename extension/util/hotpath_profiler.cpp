@@ -0,0 +1,480 @@
+#include NAVBOT_PCH_FILE
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include <extension.h>
+#include <manager.h>
+#include <bot/basebot.h>
+#include "hotpath_profiler.h"
+
+#if SOURCE_ENGINE <= SE_DARKMESSIAH
+#include <util/commandargs_episode1.h>
+#endif // SOURCE_ENGINE <= SE_DARKMESSIAH
+
+static ConVar cvar_profiler_enabled("sm_navbot_profiler", "0", FCVAR_GAMEDLL, "Enables the NavBot hot path profiler. See sm_navbot_profiler_dump.");
+
+namespace hotprof
+{
+	// values below this are stored in individual buckets, values above use 4 buckets per power of two
+	static constexpr std::uint64_t LINEAR_LIMIT = 16U;
+	static constexpr std::size_t SUB_BUCKETS_SHIFT = 2U;
+	static constexpr std::size_t SUB_BUCKETS = 1U << SUB_BUCKETS_SHIFT;
+	static constexpr std::size_t NUM_BUCKETS = LINEAR_LIMIT + (64U - 4U) * SUB_BUCKETS;
+	static constexpr int MAX_BOTS = 256;
+	static constexpr std::size_t MAX_TRACE_EVENTS_PER_THREAD = 1000000U;
+
+	static std::size_t HighestBit(std::uint64_t value)
+	{
+		std::size_t bit = 0U;
+
+		for (std::size_t shift = 32U; shift > 0U; shift >>= 1U)
+		{
+			if (value >= (static_cast<std::uint64_t>(1U) << shift))
+			{
+				value >>= shift;
+				bit += shift;
+			}
+		}
+
+		return bit;
+	}
+
+	static std::size_t GetBucketIndex(std::uint64_t ns)
+	{
+		if (ns < LINEAR_LIMIT)
+		{
+			return static_cast<std::size_t>(ns);
+		}
+
+		const std::size_t exponent = HighestBit(ns);
+		const std::size_t sub = static_cast<std::size_t>(ns >> (exponent - SUB_BUCKETS_SHIFT)) & (SUB_BUCKETS - 1U);
+		return LINEAR_LIMIT + (exponent - 4U) * SUB_BUCKETS + sub;
+	}
+
+	// Middle of the bucket range
+	static double GetBucketValue(std::size_t index)
+	{
+		if (index < LINEAR_LIMIT)
+		{
+			return static_cast<double>(index);
+		}
+
+		const std::size_t exponent = (index - LINEAR_LIMIT) / SUB_BUCKETS + 4U;
+		const std::size_t sub = (index - LINEAR_LIMIT) % SUB_BUCKETS;
+		const double step = static_cast<double>(static_cast<std::uint64_t>(1U) << (exponent - SUB_BUCKETS_SHIFT));
+		return static_cast<double>(static_cast<std::uint64_t>(1U) << exponent) + step * (static_cast<double>(sub) + 0.5);
+	}
+
+	// Histogram with a single writer, readers may see slightly outdated values
+	struct Histogram
+	{
+		std::array<std::atomic<std::uint32_t>, NUM_BUCKETS> buckets{};
+		std::atomic<std::uint64_t> count{ 0U };
+		std::atomic<std::uint64_t> totalNs{ 0U };
+		std::atomic<std::uint64_t> maxNs{ 0U };
+
+		void Add(std::uint64_t ns)
+		{
+			std::atomic<std::uint32_t>& bucket = buckets[GetBucketIndex(ns)];
+			bucket.store(bucket.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+			count.store(count.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+			totalNs.store(totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+
+			if (ns > maxNs.load(std::memory_order_relaxed))
+			{
+				maxNs.store(ns, std::memory_order_relaxed);
+			}
+		}
+
+		void Clear()
+		{
+			for (auto& bucket : buckets)
+			{
+				bucket.store(0U, std::memory_order_relaxed);
+			}
+
+			count.store(0U, std::memory_order_relaxed);
+			totalNs.store(0U, std::memory_order_relaxed);
+			maxNs.store(0U, std::memory_order_relaxed);
+		}
+	};
+
+	// Merged copy of one or more histograms
+	struct HistogramSnapshot
+	{
+		std::array<std::uint64_t, NUM_BUCKETS> buckets{};
+		std::uint64_t count = 0U;
+		std::uint64_t totalNs = 0U;
+		std::uint64_t maxNs = 0U;
+
+		void Merge(const Histogram& histogram)
+		{
+			for (std::size_t i = 0U; i < NUM_BUCKETS; i++)
+			{
+				buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+			}
+
+			count += histogram.count.load(std::memory_order_relaxed);
+			totalNs += histogram.totalNs.load(std::memory_order_relaxed);
+			maxNs = std::max(maxNs, histogram.maxNs.load(std::memory_order_relaxed));
+		}
+
+		// Gets the given percentile (0 to 1) in nanoseconds
+		double GetPercentile(double percentile) const
+		{
+			std::uint64_t total = 0U;
+
+			for (const std::uint64_t value : buckets)
+			{
+				total += value;
+			}
+
+			if (total == 0U)
+			{
+				return 0.0;
+			}
+
+			const std::uint64_t target = std::max(static_cast<std::uint64_t>(percentile * static_cast<double>(total) + 0.5), static_cast<std::uint64_t>(1U));
+			std::uint64_t accumulated = 0U;
+
+			for (std::size_t i = 0U; i < NUM_BUCKETS; i++)
+			{
+				accumulated += buckets[i];
+
+				if (accumulated >= target)
+				{
+					return std::min(GetBucketValue(i), static_cast<double>(maxNs));
+				}
+			}
+
+			return static_cast<double>(maxNs);
+		}
+	};
+
+	struct TraceEvent
+	{
+		ScopeID scope;
+		std::int64_t startNs;
+		std::int64_t durationNs;
+	};
+
+	struct ThreadData
+	{
+		std::uint32_t index;
+		std::array<Histogram, MAX_SCOPES> scopes;
+		std::mutex traceMutex;
+		std::vector<TraceEvent> traceEvents;
+	};
+
+	using BotHistograms = std::array<Histogram, MAX_SCOPES>;
+
+	static std::mutex s_scopesMutex;
+	static std::array<const char*, MAX_SCOPES> s_scopeNames{};
+	static std::atomic<ScopeID> s_scopeCount{ 0U };
+
+	static std::mutex s_threadsMutex;
+	static std::vector<std::unique_ptr<ThreadData>> s_threads;
+	static thread_local ThreadData* s_threadData = nullptr;
+
+	// only written and read by the main thread
+	static std::array<std::unique_ptr<BotHistograms>, MAX_BOTS> s_bots;
+	static thread_local int s_currentBot = 0;
+
+	static std::atomic<bool> s_tracing{ false };
+	static int s_traceTicksLeft = 0;
+	static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+	std::atomic<bool> detail::s_enabled{ false };
+
+	static ThreadData* GetThreadData()
+	{
+		if (s_threadData == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(s_threadsMutex);
+			auto& data = s_threads.emplace_back(std::make_unique<ThreadData>());
+			data->index = static_cast<std::uint32_t>(s_threads.size());
+			s_threadData = data.get();
+		}
+
+		return s_threadData;
+	}
+
+	static ScopeID GetScopeCount()
+	{
+		return s_scopeCount.load(std::memory_order_acquire);
+	}
+
+	static void WriteTrace()
+	{
+		std::unique_ptr<char[]> szPath = std::make_unique<char[]>(PLATFORM_MAX_PATH);
+		smutils->BuildPath(SourceMod::Path_SM, szPath.get(), PLATFORM_MAX_PATH, "logs/navbot_trace.json");
+		std::fstream file;
+		file.open(szPath.get(), std::fstream::out | std::fstream::trunc);
+
+		if (!file.is_open())
+		{
+			smutils->LogError(myself, "Failed to open \"%s\" for writing the profiler trace!", szPath.get());
+			return;
+		}
+
+		file << std::fixed;
+		file.precision(3);
+		std::size_t numEvents = 0U;
+		bool first = true;
+		file << "{\"traceEvents\":[\n";
+
+		std::lock_guard<std::mutex> lock(s_threadsMutex);
+
+		for (auto& thread : s_threads)
+		{
+			std::lock_guard<std::mutex> tracelock(thread->traceMutex);
+
+			for (const TraceEvent& event : thread->traceEvents)
+			{
+				if (!first)
+				{
+					file << ",\n";
+				}
+
+				first = false;
+				numEvents++;
+				// Chrome trace timestamps are in microseconds
+				file << "{\"name\":\"" << s_scopeNames[event.scope] << "\",\"cat\":\"NavBot\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->index
+					<< ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0 << ",\"dur\":" << static_cast<double>(event.durationNs) / 1000.0 << "}";
+			}
+
+			thread->traceEvents.clear();
+			thread->traceEvents.shrink_to_fit();
+		}
+
+		file << "\n]}\n";
+		file.close();
+
+		META_CONPRINTF("Profiler trace with %zu events saved to \"%s\". Open it with chrome://tracing or Perfetto.\n", numEvents, szPath.get());
+	}
+
+	static void PrintHistogram(const char* name, const HistogramSnapshot& snapshot)
+	{
+		const double mean = snapshot.count > 0U ? static_cast<double>(snapshot.totalNs) / static_cast<double>(snapshot.count) : 0.0;
+
+		META_CONPRINTF("%-40s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f\n", name, static_cast<unsigned long long>(snapshot.count), mean / 1000.0,
+			snapshot.GetPercentile(0.50) / 1000.0, snapshot.GetPercentile(0.95) / 1000.0, snapshot.GetPercentile(0.99) / 1000.0,
+			static_cast<double>(snapshot.maxNs) / 1000.0);
+	}
+}
+
+std::int64_t hotprof::detail::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+void hotprof::detail::Record(ScopeID id, std::int64_t startNs, std::int64_t endNs)
+{
+	const std::uint64_t duration = endNs > startNs ? static_cast<std::uint64_t>(endNs - startNs) : 0U;
+	ThreadData* data = GetThreadData();
+	data->scopes[id].Add(duration);
+
+	if (s_currentBot > 0 && s_currentBot < MAX_BOTS)
+	{
+		auto& bot = s_bots[s_currentBot];
+
+		if (!bot)
+		{
+			bot = std::make_unique<BotHistograms>();
+		}
+
+		(*bot)[id].Add(duration);
+	}
+
+	if (s_tracing.load(std::memory_order_relaxed))
+	{
+		std::lock_guard<std::mutex> lock(data->traceMutex);
+
+		if (data->traceEvents.size() < MAX_TRACE_EVENTS_PER_THREAD)
+		{
+			data->traceEvents.push_back({ id, startNs, static_cast<std::int64_t>(duration) });
+		}
+	}
+}
+
+hotprof::ScopeID hotprof::RegisterScope(const char* name)
+{
+	std::lock_guard<std::mutex> lock(s_scopesMutex);
+	const ScopeID count = s_scopeCount.load(std::memory_order_relaxed);
+
+	// scopes with the same name share the histograms
+	for (ScopeID i = 0U; i < count; i++)
+	{
+		if (std::strcmp(s_scopeNames[i], name) == 0)
+		{
+			return i;
+		}
+	}
+
+	if (count >= MAX_SCOPES)
+	{
+		return INVALID_SCOPE;
+	}
+
+	s_scopeNames[count] = name;
+	s_scopeCount.store(count + 1U, std::memory_order_release);
+	return count;
+}
+
+void hotprof::OnFrameEnd()
+{
+	if (s_tracing.load(std::memory_order_relaxed) && --s_traceTicksLeft <= 0)
+	{
+		s_tracing.store(false, std::memory_order_relaxed);
+		WriteTrace();
+	}
+
+	detail::s_enabled.store(cvar_profiler_enabled.GetBool() || s_tracing.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void hotprof::ResetBot(int client)
+{
+	if (client > 0 && client < MAX_BOTS)
+	{
+		s_bots[client].reset();
+	}
+}
+
+hotprof::BotScope::BotScope(int client)
+{
+	m_previous = s_currentBot;
+	s_currentBot = client;
+}
+
+hotprof::BotScope::~BotScope()
+{
+	s_currentBot = m_previous;
+}
+
+CON_COMMAND_F(sm_navbot_profiler_dump, "Prints the hot path profiler timings. Pass 'bots' to also print the timings of each bot.", FCVAR_GAMEDLL)
+{
+	DECLARE_COMMAND_ARGS;
+
+	using namespace hotprof;
+
+	if (!IsEnabled())
+	{
+		META_CONPRINT("Profiler is disabled, set sm_navbot_profiler to 1 to start collecting timings.\n");
+	}
+
+	const ScopeID numScopes = GetScopeCount();
+
+	META_CONPRINT("--- NavBot Hot Path Profiler (times in microseconds) ---\n");
+	META_CONPRINTF("%-40s %10s %10s %10s %10s %10s %10s\n", "Scope", "Calls", "Mean", "P50", "P95", "P99", "Max");
+
+	for (ScopeID id = 0U; id < numScopes; id++)
+	{
+		HistogramSnapshot snapshot;
+
+		{
+			std::lock_guard<std::mutex> lock(s_threadsMutex);
+
+			for (auto& thread : s_threads)
+			{
+				snapshot.Merge(thread->scopes[id]);
+			}
+		}
+
+		if (snapshot.count > 0U)
+		{
+			PrintHistogram(s_scopeNames[id], snapshot);
+		}
+	}
+
+	if (args.ArgC() < 2 || std::strcmp(args[1], "bots") != 0)
+	{
+		return;
+	}
+
+	auto functor = [&numScopes](CBaseBot* bot) {
+		const int client = bot->GetIndex();
+
+		if (client <= 0 || client >= MAX_BOTS || !s_bots[client])
+		{
+			return;
+		}
+
+		META_CONPRINTF("Bot %s:\n", bot->GetDebugIdentifier());
+
+		for (ScopeID id = 0U; id < numScopes; id++)
+		{
+			HistogramSnapshot snapshot;
+			snapshot.Merge((*s_bots[client])[id]);
+
+			if (snapshot.count > 0U)
+			{
+				PrintHistogram(s_scopeNames[id], snapshot);
+			}
+		}
+	};
+
+	extmanager->ForEachBot(functor);
+}
+
+CON_COMMAND_F(sm_navbot_profiler_reset, "Clears the hot path profiler timings.", FCVAR_GAMEDLL)
+{
+	using namespace hotprof;
+
+	{
+		std::lock_guard<std::mutex> lock(s_threadsMutex);
+
+		for (auto& thread : s_threads)
+		{
+			for (auto& histogram : thread->scopes)
+			{
+				histogram.Clear();
+			}
+		}
+	}
+
+	for (auto& bot : s_bots)
+	{
+		bot.reset();
+	}
+
+	META_CONPRINT("Profiler timings cleared.\n");
+}
+
+CON_COMMAND_F(sm_navbot_profiler_trace, "Records a Chrome trace JSON file of the profiled scopes for the given number of ticks.", FCVAR_GAMEDLL)
+{
+	DECLARE_COMMAND_ARGS;
+
+	if (args.ArgC() < 2)
+	{
+		META_CONPRINT("[SM] Usage: sm_navbot_profiler_trace <ticks>\n");
+		return;
+	}
+
+	const int ticks = atoi(args[1]);
+
+	if (ticks <= 0 || ticks > 3000)
+	{
+		META_CONPRINT("Number of ticks must be between 1 and 3000!\n");
+		return;
+	}
+
+	using namespace hotprof;
+
+	if (s_tracing.load(std::memory_order_relaxed))
+	{
+		META_CONPRINT("A trace is already being recorded!\n");
+		return;
+	}
+
+	s_traceTicksLeft = ticks;
+	s_tracing.store(true, std::memory_order_relaxed);
+	detail::s_enabled.store(true, std::memory_order_relaxed);
+
+	META_CONPRINTF("Recording profiler trace for %i ticks.\n", ticks);
+}
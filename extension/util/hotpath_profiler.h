@@ -0,0 +1,98 @@
+#ifndef __NAVBOT_UTIL_HOTPATH_PROFILER_H_
+#define __NAVBOT_UTIL_HOTPATH_PROFILER_H_
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+/**
+ * @brief Built-in profiler for the extension hot paths.
+ *
+ * Scoped timers are always compiled in, when the profiler is disabled (sm_navbot_profiler 0) they only read a flag.
+ * Timings are recorded into per thread log-linear histograms, no locks are taken unless a Chrome trace is being recorded.
+ * Scopes running while a bot thinks are also recorded into that bot's histograms (main thread only).
+ */
+namespace hotprof
+{
+	using ScopeID = std::uint32_t;
+
+	static constexpr ScopeID MAX_SCOPES = 64U;
+	static constexpr ScopeID INVALID_SCOPE = MAX_SCOPES;
+
+	namespace detail
+	{
+		extern std::atomic<bool> s_enabled;
+
+		void Record(ScopeID id, std::int64_t startNs, std::int64_t endNs);
+		std::int64_t Now();
+	}
+
+	inline bool IsEnabled() { return detail::s_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Registers a profiler scope. Use the NAVBOT_PROFILE_SCOPE macro instead of calling this directly.
+	 * @param name Scope name, must be a string literal or have static storage.
+	 * @return Scope ID or INVALID_SCOPE if there are too many scopes.
+	 */
+	ScopeID RegisterScope(const char* name);
+	// Called once per server frame, updates the enabled status and the trace recording.
+	void OnFrameEnd();
+	// Clears the histograms of a bot, called when the bot leaves
+	void ResetBot(int client);
+
+	// Times the enclosing scope
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(ScopeID id)
+		{
+			if (!IsEnabled() || id == INVALID_SCOPE)
+			{
+				m_id = INVALID_SCOPE;
+				return;
+			}
+
+			m_id = id;
+			m_start = detail::Now();
+		}
+
+		~ScopedTimer()
+		{
+			if (m_id != INVALID_SCOPE)
+			{
+				detail::Record(m_id, m_start, detail::Now());
+			}
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		ScopeID m_id;
+		std::int64_t m_start;
+	};
+
+	// Scopes timed while this is alive are also recorded to the given bot.
+	class BotScope
+	{
+	public:
+		BotScope(int client);
+		~BotScope();
+
+		BotScope(const BotScope&) = delete;
+		BotScope& operator=(const BotScope&) = delete;
+
+	private:
+		int m_previous;
+	};
+}
+
+#define NAVBOT_PROFILE_CONCAT_IMPL(A, B) A##B
+#define NAVBOT_PROFILE_CONCAT(A, B) NAVBOT_PROFILE_CONCAT_IMPL(A, B)
+
+// Times the current scope with the hot path profiler
+#define NAVBOT_PROFILE_SCOPE(NAME)																							\
+	static const hotprof::ScopeID NAVBOT_PROFILE_CONCAT(__hotprof_scope_, __LINE__) = hotprof::RegisterScope(NAME);		\
+	hotprof::ScopedTimer NAVBOT_PROFILE_CONCAT(__hotprof_timer_, __LINE__)(NAVBOT_PROFILE_CONCAT(__hotprof_scope_, __LINE__))
+
+#endif // !__NAVBOT_UTIL_HOTPATH_PROFILER_H_
@@ -0,0 +1,206 @@
+#include NAVBOT_PCH_FILE
+#include <atomic>
+#include <array>
+#include "memory_tracker.h"
+
+namespace memtracker
+{
+	struct AtomicCounters
+	{
+		std::atomic<std::size_t> live{ 0U };
+		std::atomic<std::size_t> peak{ 0U };
+	};
+
+	struct CategoryCounters
+	{
+		AtomicCounters bytes;
+		std::atomic<std::size_t> allocations{ 0U };
+		std::atomic<std::size_t> frees{ 0U };
+	};
+
+	static std::array<CategoryCounters, MAX_CATEGORIES> s_categories;
+	static std::array<std::array<AtomicCounters, MAX_CATEGORIES>, MAX_OWNERS> s_owners;
+	static std::array<std::atomic<std::uint32_t>, MAX_OWNERS> s_generations{};
+	static thread_local std::uint32_t s_currentOwner = NO_OWNER;
+
+	static void AddBytes(AtomicCounters& counters, std::size_t bytes)
+	{
+		const std::size_t live = counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+		std::size_t peak = counters.peak.load(std::memory_order_relaxed);
+
+		while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	static void SubtractBytes(AtomicCounters& counters, std::size_t bytes)
+	{
+		counters.live.fetch_sub(bytes, std::memory_order_relaxed);
+	}
+
+	static std::size_t GetCategoryIndex(Category category)
+	{
+		return static_cast<std::size_t>(category);
+	}
+}
+
+const char* memtracker::GetCategoryName(Category category)
+{
+	switch (category)
+	{
+	case Category::NAV_AREAS:
+		return "Nav Areas";
+	case Category::NAV_LADDERS:
+		return "Nav Ladders";
+	case Category::HIDING_SPOTS:
+		return "Hiding Spots";
+	case Category::WAYPOINTS:
+		return "Waypoints";
+	case Category::PATH_SEGMENTS:
+		return "Path Segments";
+	case Category::KNOWN_ENTITIES:
+		return "Known Entities";
+	case Category::TASKS:
+		return "AI Tasks";
+	case Category::SHARED_MEMORY:
+		return "Shared Memory";
+	case Category::WEAPON_INFO:
+		return "Weapon Info";
+	default:
+		return "Unknown";
+	}
+}
+
+memtracker::CategoryStats memtracker::GetCategoryStats(Category category)
+{
+	const CategoryCounters& counters = s_categories[GetCategoryIndex(category)];
+	CategoryStats stats;
+	stats.liveBytes = counters.bytes.live.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.bytes.peak.load(std::memory_order_relaxed);
+	stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+	stats.frees = counters.frees.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::size_t memtracker::GetOwnerLiveBytes(std::uint32_t owner, Category category)
+{
+	if (owner >= MAX_OWNERS)
+	{
+		return 0U;
+	}
+
+	return s_owners[owner][GetCategoryIndex(category)].live.load(std::memory_order_relaxed);
+}
+
+std::size_t memtracker::GetOwnerPeakBytes(std::uint32_t owner, Category category)
+{
+	if (owner >= MAX_OWNERS)
+	{
+		return 0U;
+	}
+
+	return s_owners[owner][GetCategoryIndex(category)].peak.load(std::memory_order_relaxed);
+}
+
+void memtracker::ResetOwner(std::uint32_t owner)
+{
+	if (owner >= MAX_OWNERS || owner == NO_OWNER)
+	{
+		return;
+	}
+
+	// frees of allocations from the previous generation are charged to the unowned counters
+	s_generations[owner].fetch_add(1U, std::memory_order_relaxed);
+
+	// memory still allocated is moved to the unowned counters
+	for (std::size_t i = 0U; i < MAX_CATEGORIES; i++)
+	{
+		const std::size_t live = s_owners[owner][i].live.load(std::memory_order_relaxed);
+
+		if (live > 0U)
+		{
+			AddBytes(s_owners[NO_OWNER][i], live);
+		}
+
+		s_owners[owner][i].live.store(0U, std::memory_order_relaxed);
+		s_owners[owner][i].peak.store(0U, std::memory_order_relaxed);
+	}
+}
+
+std::uint32_t memtracker::GetCurrentOwner()
+{
+	return s_currentOwner;
+}
+
+memtracker::OwnerTag memtracker::GetCurrentOwnerTag()
+{
+	const std::uint32_t owner = s_currentOwner;
+	return { owner, s_generations[owner].load(std::memory_order_relaxed) };
+}
+
+void memtracker::RecordAllocation(Category category, std::size_t bytes, const OwnerTag& tag)
+{
+	const std::size_t index = GetCategoryIndex(category);
+	CategoryCounters& counters = s_categories[index];
+	AddBytes(counters.bytes, bytes);
+	counters.allocations.fetch_add(1U, std::memory_order_relaxed);
+
+	if (tag.owner < MAX_OWNERS)
+	{
+		AddBytes(s_owners[tag.owner][index], bytes);
+	}
+}
+
+void memtracker::RecordFree(Category category, std::size_t bytes, const OwnerTag& tag)
+{
+	const std::size_t index = GetCategoryIndex(category);
+	CategoryCounters& counters = s_categories[index];
+	SubtractBytes(counters.bytes, bytes);
+	counters.frees.fetch_add(1U, std::memory_order_relaxed);
+
+	if (tag.owner < MAX_OWNERS)
+	{
+		std::uint32_t owner = tag.owner;
+
+		// the owner was reset after this was allocated, ResetOwner moved the bytes to the unowned counters
+		if (tag.generation != s_generations[owner].load(std::memory_order_relaxed))
+		{
+			owner = NO_OWNER;
+		}
+
+		SubtractBytes(s_owners[owner][index], bytes);
+	}
+}
+
+void* memtracker::Allocate(Category category, std::size_t bytes)
+{
+	std::uint8_t* base = static_cast<std::uint8_t*>(::operator new(bytes + HEADER_SIZE));
+	const OwnerTag tag = GetCurrentOwnerTag();
+	*reinterpret_cast<OwnerTag*>(base) = tag;
+	RecordAllocation(category, bytes, tag);
+	return base + HEADER_SIZE;
+}
+
+void memtracker::Free(Category category, void* ptr, std::size_t bytes)
+{
+	if (ptr == nullptr)
+	{
+		return;
+	}
+
+	std::uint8_t* base = static_cast<std::uint8_t*>(ptr) - HEADER_SIZE;
+	const OwnerTag tag = *reinterpret_cast<const OwnerTag*>(base);
+	RecordFree(category, bytes, tag);
+	::operator delete(base);
+}
+
+memtracker::OwnerScope::OwnerScope(int owner)
+{
+	m_previous = s_currentOwner;
+	s_currentOwner = (owner > 0 && static_cast<std::uint32_t>(owner) < MAX_OWNERS) ? static_cast<std::uint32_t>(owner) : NO_OWNER;
+}
+
+memtracker::OwnerScope::~OwnerScope()
+{
+	s_currentOwner = m_previous;
+}
@@ -0,0 +1,149 @@
+#ifndef __NAVBOT_UTIL_MEMORY_TRACKER_H_
+#define __NAVBOT_UTIL_MEMORY_TRACKER_H_
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/**
+ * @brief Memory accounting per subsystem.
+ *
+ * Allocations made through TrackedAllocator and CTrackedObject are counted under a category and under the
+ * current owner (the bot running think, see OwnerScope). Counters are updated atomically.
+ */
+namespace memtracker
+{
+	enum class Category : int
+	{
+		NAV_AREAS = 0,
+		NAV_LADDERS,
+		HIDING_SPOTS,
+		WAYPOINTS,
+		PATH_SEGMENTS,
+		KNOWN_ENTITIES,
+		TASKS,
+		SHARED_MEMORY,
+		WEAPON_INFO,
+
+		MAX_CATEGORIES
+	};
+
+	static constexpr std::size_t MAX_CATEGORIES = static_cast<std::size_t>(Category::MAX_CATEGORIES);
+	// Owners are client indexes, 0 is used for allocations not made by a bot
+	static constexpr std::uint32_t MAX_OWNERS = 256U;
+	static constexpr std::uint32_t NO_OWNER = 0U;
+
+	// Owner of an allocation. The generation changes every time the owner is reset so frees of a previous bot using the same client index are ignored.
+	struct OwnerTag
+	{
+		std::uint32_t owner;
+		std::uint32_t generation;
+	};
+
+	// Size of the header storing the owner tag in front of tracked allocations, keeps the user memory aligned
+	static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t) >= sizeof(OwnerTag) ? alignof(std::max_align_t) : sizeof(OwnerTag);
+
+	struct CategoryStats
+	{
+		std::size_t liveBytes;
+		std::size_t peakBytes;
+		std::size_t allocations; // total number of allocations since the extension was loaded
+		std::size_t frees; // total number of frees since the extension was loaded
+	};
+
+	const char* GetCategoryName(Category category);
+	CategoryStats GetCategoryStats(Category category);
+	// Live bytes of an owner in the given category
+	std::size_t GetOwnerLiveBytes(std::uint32_t owner, Category category);
+	// Peak bytes of an owner in the given category
+	std::size_t GetOwnerPeakBytes(std::uint32_t owner, Category category);
+	// Clears the counters of an owner and starts a new generation, called when a bot is removed
+	void ResetOwner(std::uint32_t owner);
+
+	// Owner of allocations made by the current thread
+	std::uint32_t GetCurrentOwner();
+	// Owner and owner generation of allocations made by the current thread
+	OwnerTag GetCurrentOwnerTag();
+
+	/**
+	 * @brief Records an allocation made outside of the tracked allocators.
+	 * @param category Allocation category.
+	 * @param bytes Number of bytes allocated.
+	 * @param tag Allocation owner, must be stored and passed to RecordFree.
+	 */
+	void RecordAllocation(Category category, std::size_t bytes, const OwnerTag& tag = OwnerTag{ NO_OWNER, 0U });
+	// Records a free of memory added with RecordAllocation
+	void RecordFree(Category category, std::size_t bytes, const OwnerTag& tag = OwnerTag{ NO_OWNER, 0U });
+
+	// Allocates memory with a header storing the owner tag
+	void* Allocate(Category category, std::size_t bytes);
+	// Frees memory allocated with Allocate
+	void Free(Category category, void* ptr, std::size_t bytes);
+
+	// Sets the owner of allocations made by the current thread while in scope
+	class OwnerScope
+	{
+	public:
+		OwnerScope(int owner);
+		~OwnerScope();
+
+		OwnerScope(const OwnerScope&) = delete;
+		OwnerScope& operator=(const OwnerScope&) = delete;
+
+	private:
+		std::uint32_t m_previous;
+	};
+
+	/**
+	 * @brief Allocator for standard containers that counts the memory under the given category.
+	 * @tparam T Value type.
+	 * @tparam C Memory category.
+	 */
+	template <typename T, Category C>
+	class TrackedAllocator
+	{
+	public:
+		using value_type = T;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = TrackedAllocator<U, C>;
+		};
+
+		TrackedAllocator() noexcept {}
+		template <typename U>
+		TrackedAllocator(const TrackedAllocator<U, C>& other) noexcept {}
+
+		T* allocate(std::size_t n)
+		{
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Over aligned types are not supported!");
+			return static_cast<T*>(memtracker::Allocate(C, n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			memtracker::Free(C, p, n * sizeof(T));
+		}
+
+		template <typename U>
+		bool operator==(const TrackedAllocator<U, C>& other) const noexcept { return true; }
+		template <typename U>
+		bool operator!=(const TrackedAllocator<U, C>& other) const noexcept { return false; }
+	};
+
+	/**
+	 * @brief Base class for heap allocated objects that should be counted under the given category.
+	 * @tparam C Memory category.
+	 */
+	template <Category C>
+	class CTrackedObject
+	{
+	public:
+		static void* operator new(std::size_t size) { return memtracker::Allocate(C, size); }
+		static void operator delete(void* ptr, std::size_t size) { memtracker::Free(C, ptr, size); }
+	};
+}
+
+#endif // !__NAVBOT_UTIL_MEMORY_TRACKER_H_
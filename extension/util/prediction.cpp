@@ -1,5 +1,6 @@
 #include NAVBOT_PCH_FILE
 #include <algorithm>
+#include <cmath>
 
 #include <extension.h>
 #include <manager.h>
@@ -91,8 +92,8 @@ Vector pred::IterativeEnginePredictedProjectileLead(CBaseEntity* target, const V
 	VPROF_BUDGET("pred::IterativeEnginePredictedProjectileLead", "NavBot");
 #endif // EXT_VPROF_ENABLED
 
-	CEnginePrediction enginepred;
-	enginepred.SetTraceMask(MASK_PLAYERSOLID);
+	// the target trajectory is shared between all bots and iterations on this tick
+	CTrajectoryCache& cache = CTrajectoryCache::GetInstance();
 	Vector targetPos = initialTargetPosition;
 	Vector targetDir = targetPos - shooterPosition;
 	float range = targetDir.NormalizeInPlace();
@@ -100,8 +101,7 @@ Vector pred::IterativeEnginePredictedProjectileLead(CBaseEntity* target, const V
 
 	for (int i = 0; i < maxIterations; i++)
 	{
-		enginepred.PredictUntilGround(target, time);
-		Vector predictedPosition = enginepred.GetPredictionData().pos;
+		Vector predictedPosition = cache.GetPredictedPosition(target, time, MASK_PLAYERSOLID);
 
 		targetDir = predictedPosition - shooterPosition;
 		range = targetDir.NormalizeInPlace();
@@ -186,6 +186,111 @@ Vector pred::IterativeBallisticLead(const Vector& shooterPosition, const Vector&
 	return targetPos;
 }
 
+bool pred::SolveInterceptTime(const Vector& relativePosition, const Vector& targetVelocity, const float projectileSpeed, float& time)
+{
+	constexpr float EPSILON = 1e-6f;
+
+	if (projectileSpeed <= EPSILON)
+	{
+		return false;
+	}
+
+	// |D + V * t| = s * t
+	// (V.V - s^2) * t^2 + 2 * (D.V) * t + D.D = 0
+	const float speedSqr = projectileSpeed * projectileSpeed;
+	const float a = targetVelocity.Dot(targetVelocity) - speedSqr;
+	const float b = 2.0f * relativePosition.Dot(targetVelocity);
+	const float c = relativePosition.Dot(relativePosition);
+	float t = -1.0f;
+
+	if (std::fabs(a) <= EPSILON)
+	{
+		if (b < 0.0f)
+		{
+			t = -c / b;
+		}
+	}
+	else
+	{
+		const float disc = (b * b) - (4.0f * a * c);
+
+		if (disc >= 0.0f)
+		{
+			// numerically stable roots
+			const float q = -0.5f * (b + std::copysign(std::sqrt(disc), b));
+			const float t1 = q / a;
+			const float t2 = (std::fabs(q) > EPSILON) ? c / q : -1.0f;
+
+			if (t1 > 0.0f && t2 > 0.0f)
+			{
+				t = std::min(t1, t2);
+			}
+			else
+			{
+				t = std::max(t1, t2);
+			}
+		}
+	}
+
+	if (t <= 0.0f)
+	{
+		return false;
+	}
+
+	time = t;
+	return true;
+}
+
+Vector pred::AnalyticProjectileLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const float projectileSpeed)
+{
+	float time = 0.0f;
+
+	if (!SolveInterceptTime(initialTargetPosition - shooterPosition, targetVelocity, projectileSpeed, time))
+	{
+		// target is outrunning the projectile, use the old estimate
+		return IterativeProjectileLead(shooterPosition, initialTargetPosition, targetVelocity, projectileSpeed, 1);
+	}
+
+	return initialTargetPosition + (targetVelocity * time);
+}
+
+Vector pred::AnalyticBallisticLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const ProjectileData_t& data)
+{
+	float time = 0.0f;
+
+	if (!SolveInterceptTime(initialTargetPosition - shooterPosition, targetVelocity, data.speed, time))
+	{
+		return IterativeBallisticLead(shooterPosition, initialTargetPosition, targetVelocity, data, 1);
+	}
+
+	Vector predictedPosition = initialTargetPosition + (targetVelocity * time);
+	const float range = (predictedPosition - shooterPosition).Length();
+	const float elevation_rate = RemapValClamped(range, data.ballistic_start_range, data.ballistic_end_range,
+		data.ballistic_min_rate, data.ballistic_max_rate);
+	predictedPosition.z += GravityComp(range, data.gravity, elevation_rate);
+	return predictedPosition;
+}
+
+Vector pred::ProjectileLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const float projectileSpeed, const int maxIterations)
+{
+	if (maxIterations <= 1)
+	{
+		return IterativeProjectileLead(shooterPosition, initialTargetPosition, targetVelocity, projectileSpeed, maxIterations);
+	}
+
+	return AnalyticProjectileLead(shooterPosition, initialTargetPosition, targetVelocity, projectileSpeed);
+}
+
+Vector pred::BallisticLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const ProjectileData_t& data, const int maxIterations)
+{
+	if (maxIterations <= 1)
+	{
+		return IterativeBallisticLead(shooterPosition, initialTargetPosition, targetVelocity, data, maxIterations);
+	}
+
+	return AnalyticBallisticLead(shooterPosition, initialTargetPosition, targetVelocity, data);
+}
+
 Vector pred::PredictStraightProjectileHitPosition(CBaseEntity* projectile, unsigned int mask, const float maxtime)
 {
 	Vector projOrigin = UtilHelpers::getEntityOrigin(projectile);
@@ -299,6 +404,103 @@ void pred::CEnginePrediction::RunPrediction(CBaseEntity* entity)
 #endif // EXT_DEBUG
 }
 
+pred::CTrajectoryCache::CTrajectoryCache()
+{
+	m_trajectories.reserve(32);
+}
+
+pred::CTrajectoryCache& pred::CTrajectoryCache::GetInstance()
+{
+	static CTrajectoryCache cache;
+	return cache;
+}
+
+Vector pred::CTrajectoryCache::GetPredictedPosition(CBaseEntity* entity, float time, unsigned int mask)
+{
+#ifdef EXT_VPROF_ENABLED
+	VPROF_BUDGET("CTrajectoryCache::GetPredictedPosition", "NavBot");
+#endif // EXT_VPROF_ENABLED
+
+	Trajectory& trajectory = GetTrajectory(entity, mask);
+	const float interval = gpGlobals->interval_per_tick;
+	const float maxSteps = std::max(std::round(MAX_PREDICTION_TIME / interval), 1.0f);
+	const float steps = std::clamp(time / interval, 1.0f, maxSteps);
+	const std::size_t lower = static_cast<std::size_t>(std::floor(steps));
+	const std::size_t upper = static_cast<std::size_t>(std::ceil(steps));
+
+	Simulate(trajectory, upper);
+
+	const Vector& start = GetStepPosition(trajectory, lower);
+	const Vector& end = GetStepPosition(trajectory, upper);
+	return start + ((end - start) * (steps - static_cast<float>(lower)));
+}
+
+pred::CTrajectoryCache::Trajectory& pred::CTrajectoryCache::GetTrajectory(CBaseEntity* entity, unsigned int mask)
+{
+	const int tick = gpGlobals->tickcount;
+	Trajectory* result = nullptr;
+
+	for (Trajectory& trajectory : m_trajectories)
+	{
+		if (trajectory.entity == entity && trajectory.mask == mask)
+		{
+			if (trajectory.tick == tick)
+			{
+				return trajectory;
+			}
+
+			result = &trajectory;
+			break;
+		}
+
+		// reuse entries from previous ticks
+		if (result == nullptr && trajectory.tick != tick)
+		{
+			result = &trajectory;
+		}
+	}
+
+	if (result == nullptr)
+	{
+		result = &m_trajectories.emplace_back();
+		result->positions.reserve(128);
+	}
+
+	result->entity = entity;
+	result->tick = tick;
+	result->mask = mask;
+	result->onGround = false;
+	result->positions.clear();
+	result->data.UpdateData(entity);
+	result->data.mask = mask;
+	return *result;
+}
+
+void pred::CTrajectoryCache::Simulate(Trajectory& trajectory, std::size_t steps)
+{
+	while (trajectory.positions.size() < steps && !trajectory.onGround)
+	{
+		sdkphysics::PhysicsToss(&trajectory.data);
+		trajectory.positions.push_back(trajectory.data.pos);
+
+		if (trajectory.data.HasFlags(FL_ONGROUND))
+		{
+			trajectory.onGround = true;
+		}
+	}
+}
+
+const Vector& pred::CTrajectoryCache::GetStepPosition(const Trajectory& trajectory, std::size_t step)
+{
+	if (trajectory.positions.empty() || step == 0U)
+	{
+		return trajectory.positions.empty() ? trajectory.data.pos : trajectory.positions.front();
+	}
+
+	// the entity doesn't move after it hits the ground
+	return trajectory.positions[std::min(step, trajectory.positions.size()) - 1U];
+}
+
 void sdkphysics::PhysicsStep(pred::PredictionEntityData* entity)
 {
 	// Now run step simulator
@@ -2,6 +2,8 @@
 #define NAVBOT_PREDICTION_LIB_H_
 #pragma once
 
+#include <vector>
+
 class CBotWeapon;
 class CBaseExtPlayer;
 class CBaseBot;
@@ -40,6 +42,27 @@ namespace pred
 	};
 
 	Vector IterativeBallisticLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const ProjectileData_t& data, const int maxIterations);
+
+	/**
+	 * @brief Solves the time a projectile fired now takes to intercept a target moving at a constant velocity.
+	 * @param relativePosition Target position relative to the shooter.
+	 * @param targetVelocity Target velocity.
+	 * @param projectileSpeed Projectile speed.
+	 * @param time Intercept time, only set if a solution is found.
+	 * @return True if a solution was found, false if the projectile can't reach the target.
+	 */
+	bool SolveInterceptTime(const Vector& relativePosition, const Vector& targetVelocity, const float projectileSpeed, float& time);
+	// Analytic equivalent of IterativeProjectileLead with infinite iterations.
+	Vector AnalyticProjectileLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const float projectileSpeed);
+	// Analytic equivalent of IterativeBallisticLead with infinite iterations.
+	Vector AnalyticBallisticLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const ProjectileData_t& data);
+	/**
+	 * @brief Projectile lead for bots. Profiles with a single prediction iteration keep the one step estimate,
+	 * higher iteration counts use the analytic solution which is what the iterations converge to.
+	 */
+	Vector ProjectileLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const float projectileSpeed, const int maxIterations);
+	// Ballistic lead for bots, see ProjectileLead.
+	Vector BallisticLead(const Vector& shooterPosition, const Vector& initialTargetPosition, const Vector& targetVelocity, const ProjectileData_t& data, const int maxIterations);
 	/**
 	 * @brief Predicts the position a straight projectile will hit/land.
 	 * This is best used for projectiles without gravity and constant speed. (IE: rockets)
@@ -124,6 +147,49 @@ namespace pred
 		PredictionEntityData m_entdata;
 		void RunPrediction(CBaseEntity* entity);
 	};
+
+	/**
+	 * @brief Shared cache of predicted entity trajectories.
+	 *
+	 * Each entity trajectory is simulated once per tick and extended on demand up to MAX_PREDICTION_TIME.
+	 * Positions are stored per simulation step, queries between steps are interpolated.
+	 */
+	class CTrajectoryCache
+	{
+	public:
+		static constexpr float MAX_PREDICTION_TIME = 3.0f;
+
+		CTrajectoryCache();
+
+		static CTrajectoryCache& GetInstance();
+
+		/**
+		 * @brief Gets the predicted position of an entity. Same as CEnginePrediction::PredictUntilGround.
+		 * @param entity Entity to predict.
+		 * @param time How many seconds in the future to predict.
+		 * @param mask Trace mask used by the simulation.
+		 * @return Predicted position.
+		 */
+		Vector GetPredictedPosition(CBaseEntity* entity, float time, unsigned int mask);
+		void Clear() { m_trajectories.clear(); }
+
+	private:
+		struct Trajectory
+		{
+			CBaseEntity* entity;
+			int tick; // tick the simulation started
+			unsigned int mask;
+			bool onGround; // simulation stopped after the entity hit the ground
+			PredictionEntityData data;
+			std::vector<Vector> positions; // position after each simulation step
+		};
+
+		std::vector<Trajectory> m_trajectories;
+
+		Trajectory& GetTrajectory(CBaseEntity* entity, unsigned int mask);
+		static void Simulate(Trajectory& trajectory, std::size_t steps);
+		static const Vector& GetStepPosition(const Trajectory& trajectory, std::size_t step);
+	};
 }
 
 namespace sdkphysics